@@ -20,6 +20,7 @@ SOURCES += ../../speccy.cpp \
 	../../z80/z80_op_tables.cpp \
 	../../z80/z80_opcodes.cpp \
 	../../z80/z80.cpp \
+	../../z80/z80_trace.cpp \
 	../../3rdparty/tinyxml2/tinyxml2.cpp \
 	../../3rdparty/zlib/zutil.c \
 	../../3rdparty/zlib/uncompr.c \
@@ -54,6 +55,10 @@ SOURCES += ../../speccy.cpp \
 	../../devices/device.cpp \
 	../../platform/qt/main_qt.cpp \
 	../../tools/profiler.cpp \
+	../../tools/crc16.cpp \
+	../../tools/file_writer.cpp \
+	../../tools/job_thread.cpp \
+	../../tools/packer.cpp \
 	../../tools/options.cpp \
 	../../tools/log.cpp \
 	../../platform/qt/io_select_qt.cpp \
@@ -80,6 +85,7 @@ HEADERS  += \
 	../../z80/z80_op_cb.h \
 	../../z80/z80_op.h \
 	../../z80/z80.h \
+	../../z80/z80_trace.h \
 	../../3rdparty/tinyxml2/tinyxml2.h \
 	../../3rdparty/zlib/zutil.h \
 	../../3rdparty/zlib/zlib.h \
@@ -117,6 +123,10 @@ HEADERS  += \
 	../../tools/tick_clock.h \
 	../../tools/tick.h \
 	../../tools/profiler.h \
+	../../tools/crc16.h \
+	../../tools/file_writer.h \
+	../../tools/job_thread.h \
+	../../tools/packer.h \
 	../../tools/options.h \
 	../../tools/log.h \
 	../../tools/list.h \
@@ -126,6 +136,7 @@ HEADERS  += \
 	../../platform/qt/qt_control.h \
 	../../platform/qt/qt_view.h \
 	../../file_type.h \
+	../../file_type_zip.h \
 	../../snapshot/rzx.h
 
 RESOURCES += unreal_speccy_portable.qrc
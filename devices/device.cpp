@@ -43,52 +43,8 @@ eDevices::~eDevices()
 //-----------------------------------------------------------------------------
 void eDevices::Init()
 {
-	int io_read_count = 0;
-	for(; items_io_read[io_read_count]; ++io_read_count);
-	int io_write_count = 0;
-	for(; items_io_write[io_write_count]; ++io_write_count);
-	assert(io_read_count <= 8 && io_write_count <= 8); //only 8 devs max supported
-
-	for(int port = 0; port < 0x10000; ++port)
-	{
-		byte devs = 0;
-		for(int d = 0; d < io_read_count; ++d)
-		{
-			if(items_io_read[d]->IoRead(port))
-				devs |= 1 << d;
-		}
-		io_read_map[port] = devs;
-		devs = 0;
-		for(int d = 0; d < io_write_count; ++d)
-		{
-			if(items_io_write[d]->IoWrite(port))
-				devs |= 1 << d;
-		}
-		io_write_map[port] = devs;
-	}
-
-	int size = 1 << io_read_count;
-	for(int i = 0; i < size; ++i)
-	{
-		eDevice** dl = io_read_cache[i];
-		for(int d = 0; d < io_read_count; ++d)
-		{
-			if((byte)i&(1 << d))
-				*dl++ = items_io_read[d];
-		}
-		*dl = NULL;
-	}
-	size = 1 << io_write_count;
-	for(int i = 0; i < size; ++i)
-	{
-		eDevice** dl = io_write_cache[i];
-		for(int d = 0; d < io_write_count; ++d)
-		{
-			if((byte)i&(1 << d))
-				*dl++ = items_io_write[d];
-		}
-		*dl = NULL;
-	}
+	io_read.Build(items_io_read, false);
+	io_write.Build(items_io_write, true);
 }
 //=============================================================================
 //	eDevices::Reset
@@ -153,3 +109,96 @@ void eDevices::_Add(eDeviceId id, eDevice* d)
 		*dl = d;
 	}
 }
+//=============================================================================
+//	eIoMap::Build
+//-----------------------------------------------------------------------------
+void eIoMap::Build(eDevice* const* _devices, bool write)
+{
+	std::vector<eEntry> e;
+	for(eDevice* const* dl = _devices; *dl; ++dl)
+	{
+		eDevice::eIoDecode d[eDevice::IO_DECODE_MAX];
+		int count = write ? (*dl)->IoWriteDecode(d) : (*dl)->IoReadDecode(d);
+		assert(count <= eDevice::IO_DECODE_MAX);
+		for(int i = 0; i < count; ++i)
+		{
+			eEntry x = { *dl, d[i] };
+			e.push_back(x);
+		}
+	}
+	if(high_bits >= 0 && e == entries)
+		return; // decode is the same since last build (reset, snapshot load)
+	entries.swap(e);
+
+	byte mask = 0;
+	for(size_t i = 0; i < entries.size(); ++i)
+	{
+		mask |= entries[i].d.mask >> 8;
+	}
+	high_bits = 0;
+	for(int h = 0; h < 0x100; ++h)
+	{
+		int idx = 0;
+		int n = 0;
+		for(int b = 0; b < 8; ++b)
+		{
+			if(!(mask & (1 << b)))
+				continue;
+			if(h & (1 << b))
+				idx |= 1 << n;
+			++n;
+		}
+		high[h] = idx << 8;
+		high_bits = n;
+	}
+	map.resize(0x100 << high_bits);
+	std::vector<std::vector<eDevice*> > sets;
+	for(int h = 0; h < 0x100; ++h)
+	{
+		if(h & ~mask)
+			continue; // the same as h & mask
+		for(int l = 0; l < 0x100; ++l)
+		{
+			word port = (h << 8) + l;
+			std::vector<eDevice*> set;
+			for(size_t i = 0; i < entries.size();)
+			{
+				eDevice* d = entries[i].device;
+				bool in = false;
+				bool except = false;
+				for(; i < entries.size() && entries[i].device == d; ++i)
+				{
+					const eDevice::eIoDecode& x = entries[i].d;
+					if((port & x.mask) != x.value)
+						continue;
+					if(x.except)
+						except = true;
+					else
+						in = true;
+				}
+				if(in && !except)
+					set.push_back(d);
+			}
+			size_t s = 0;
+			while(s < sets.size() && sets[s] != set)
+				++s;
+			if(s == sets.size())
+				sets.push_back(set);
+			assert(s < 0x100);
+			map[high[h] + l] = s;
+		}
+	}
+	devices.clear();
+	std::vector<size_t> starts;
+	for(size_t s = 0; s < sets.size(); ++s)
+	{
+		starts.push_back(devices.size());
+		devices.insert(devices.end(), sets[s].begin(), sets[s].end());
+		devices.push_back(NULL);
+	}
+	lists.clear();
+	for(size_t s = 0; s < sets.size(); ++s)
+	{
+		lists.push_back(&devices[starts[s]]);
+	}
+}
@@ -19,6 +19,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef	__DEVICE_H__
 #define	__DEVICE_H__
 
+#include <vector>
+
 #pragma once
 
 //*****************************************************************************
@@ -36,15 +38,63 @@ public:
 	virtual void FrameEnd(dword tacts) {}
 
 	enum eIoNeed { ION_READ = 0x01, ION_WRITE = 0x02 };
-	virtual bool IoRead(word port) const { return false; }
-	virtual bool IoWrite(word port) const { return false; }
+	// port is decoded by device if (port & mask) == value for any of entries
+	// but for the ones marked as except
+	struct eIoDecode
+	{
+		word	mask;
+		word	value;
+		bool	except;
+	};
+	enum { IO_DECODE_MAX = 8 };
+	// fill up to IO_DECODE_MAX entries, return count
+	virtual int IoReadDecode(eIoDecode* d) const { return 0; }
+	virtual int IoWriteDecode(eIoDecode* d) const { return 0; }
 	virtual void IoRead(word port, byte* v, int tact) {}
 	virtual void IoWrite(word port, byte v, int tact) {}
 	virtual dword IoNeed() const { return 0; }
+protected:
+	static int IoDecode(eIoDecode* d, const eIoDecode* ports, int count)
+	{
+		memcpy(d, ports, count*sizeof(eIoDecode));
+		return count;
+	}
 };
 
 enum eDeviceId { D_ROM, D_RAM, D_ULA, D_KEYBOARD, D_KEMPSTON_JOY, D_KEMPSTON_MOUSE, D_BEEPER, D_AY, D_WD1793, D_TAPE, D_COUNT };
 
+//*****************************************************************************
+//	eIoMap
+//-----------------------------------------------------------------------------
+// devices decoding each port, built from their decode entries. map is indexed
+// by low byte of port and those bits of high byte which any device decodes,
+// so it's only 256 entries per combination of these bits
+//-----------------------------------------------------------------------------
+class eIoMap
+{
+public:
+	eIoMap() : high_bits(-1) {}
+	void Build(eDevice* const* devices, bool write); // NULL terminated list
+	eDevice* const* Devices(word port) const { return lists[map[high[port >> 8] + (port & 0xff)]]; }
+
+protected:
+	struct eEntry
+	{
+		eDevice* device;
+		eDevice::eIoDecode d;
+		bool operator==(const eEntry& e) const
+		{
+			return device == e.device && d.mask == e.d.mask && d.value == e.d.value && d.except == e.d.except;
+		}
+	};
+	std::vector<eEntry> entries;
+	int		high_bits;		// count of high byte bits decoded, -1 if not built yet
+	word	high[0x100];	// high byte -> offset of its 256 entries in map
+	std::vector<byte> map;	// index of device list
+	std::vector<eDevice*> devices; // device lists, NULL terminated
+	std::vector<eDevice**> lists;
+};
+
 //*****************************************************************************
 //	eDevices
 //-----------------------------------------------------------------------------
@@ -63,14 +113,14 @@ public:
 	byte IoRead(word port, int tact)
 	{
 		byte v = 0xff;
-		eDevice** dl = io_read_cache[io_read_map[port]];
+		eDevice* const* dl = io_read.Devices(port);
 		while(*dl)
 			(*dl++)->IoRead(port, &v, tact);
 		return v;
 	}
 	void IoWrite(word port, byte v, int tact)
 	{
-		eDevice** dl = io_write_cache[io_write_map[port]];
+		eDevice* const* dl = io_write.Devices(port);
 		while(*dl)
 			(*dl++)->IoWrite(port, v, tact);
 	}
@@ -85,10 +135,8 @@ protected:
 	eDevice* items[D_COUNT];
 	eDevice* items_io_read[D_COUNT + 1];
 	eDevice* items_io_write[D_COUNT + 1];
-	byte io_read_map[0x10000];
-	byte io_write_map[0x10000];
-	eDevice* io_read_cache[0x100][9];
-	eDevice* io_write_cache[0x100][9];
+	eIoMap io_read;
+	eIoMap io_write;
 };
 
 #endif//__DEVICE_H__
@@ -19,8 +19,11 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "../../std.h"
 
 #include "fdd.h"
+#include "../../tools/crc16.h"
+#include "../../tools/file_writer.h"
 
 const int trdos_interleave = 1;
+static const byte zero_sector[1024] = { 0 }; // data of logical sector filled with zeros
 
 #define Min(o, p)	(o < p ? o : p)
 
@@ -92,26 +95,203 @@ void eUdi::eTrack::Update()
 //=============================================================================
 //	eUdi::eUdi
 //-----------------------------------------------------------------------------
-eUdi::eUdi(int _cyls, int _sides) : raw(NULL)
+eUdi::eUdi(int _cyls, int _sides)
 {
 	cyls = _cyls; sides = _sides;
 	const int max_track_len = 6250;
 	int data_len = max_track_len;
-	int udi_track_len = data_len + data_len / 8 + ((data_len & 7) ? 1 : 0);
-	int size = cyls * sides * udi_track_len;
-	raw = new byte[size];
-	memset(raw, 0, size);
+	track_len = data_len + data_len / 8 + ((data_len & 7) ? 1 : 0);
 	for(int i = 0; i < cyls; ++i)
 	{
 		for(int j = 0; j < sides; ++j)
+		{
+			tracks[i][j].data_len = data_len;
+		}
+	}
+}
+//=============================================================================
+//	eUdi::~eUdi
+//-----------------------------------------------------------------------------
+eUdi::~eUdi()
+{
+	for(int i = 0; i < MAX_CYL; ++i)
+	{
+		for(int j = 0; j < MAX_SIDE; ++j)
 		{
 			eTrack& t = tracks[i][j];
-			t.data_len = data_len;
-			t.data = raw + udi_track_len * (i * sides + j);
-			t.id = t.data + data_len;
+			SAFE_DELETE_ARRAY(t.data);
+			SAFE_DELETE_ARRAY(t.logical);
+			SAFE_DELETE_ARRAY(t.logical_data);
 		}
 	}
 }
+//=============================================================================
+//	eUdi::Format
+//-----------------------------------------------------------------------------
+eUdi::eSectorData* eUdi::Format(int cyl, int side, int sectors_amount)
+{
+	eTrack& t = tracks[cyl][side];
+	assert(!t.data && !t.logical);
+	t.logical = new eSectorData[sectors_amount ? sectors_amount : 1];
+	t.logical_amount = sectors_amount;
+	return t.logical;
+}
+//=============================================================================
+//	eUdi::SectorData
+//-----------------------------------------------------------------------------
+void eUdi::SectorData(int cyl, int side, int sec_idx, const byte* data)
+{
+	eTrack& t = tracks[cyl][side];
+	eSectorData& s = t.logical[sec_idx];
+	int len = s.Len();
+	int i = 0;
+	for(; i < len && !data[i]; ++i)
+		;
+	if(i == len && !s.data) // still filled with zeros
+		return;
+	if(!t.logical_data)
+	{
+		// keep data of whole track together, allocated only for non empty tracks
+		int size = 0;
+		for(i = 0; i < t.logical_amount; ++i)
+			size += t.logical[i].Len();
+		t.logical_data = new byte[size];
+		memset(t.logical_data, 0, size);
+		byte* ptr = t.logical_data;
+		for(i = 0; i < t.logical_amount; ++i)
+		{
+			t.logical[i].data = ptr;
+			ptr += t.logical[i].Len();
+		}
+	}
+	memcpy(s.data, data, len);
+}
+//=============================================================================
+//	eUdi::WriteSector
+//-----------------------------------------------------------------------------
+bool eUdi::WriteSector(int cyl, int side, int sec, const byte* data)
+{
+	eTrack& t = tracks[cyl][side];
+	for(int i = 0; i < t.logical_amount; ++i)
+	{
+		eSectorData& s = t.logical[i];
+		if(s.id[2] == sec && s.Len() == 256 && !(s.flags & eSectorData::F_NO_DATA))
+		{
+			SectorData(cyl, side, i, data);
+			s.flags &= ~eSectorData::F_CRC_ERROR;
+			return true;
+		}
+	}
+	return false;
+}
+//=============================================================================
+//	eUdi::ReadSector
+//-----------------------------------------------------------------------------
+const byte* eUdi::ReadSector(int cyl, int side, int sec) const
+{
+	const eTrack& t = tracks[cyl][side];
+	if(!t.logical)
+	{
+		for(int i = 0; i < t.sectors_amount; ++i)
+		{
+			const eTrack::eSector& s = t.sectors[i];
+			if(s.Sec() == sec && s.Len() == 256)
+				return s.data;
+		}
+		return NULL;
+	}
+	for(int i = 0; i < t.logical_amount; ++i)
+	{
+		const eSectorData& s = t.logical[i];
+		if(s.id[2] == sec && s.Len() == 256)
+		{
+			if(s.flags & eSectorData::F_NO_DATA)
+				return NULL;
+			return s.data ? s.data : zero_sector;
+		}
+	}
+	return NULL;
+}
+//=============================================================================
+//	eUdi::Dirty
+//-----------------------------------------------------------------------------
+bool eUdi::Dirty() const
+{
+	for(int i = 0; i < cyls; ++i)
+	{
+		for(int j = 0; j < sides; ++j)
+		{
+			if(tracks[i][j].dirty)
+				return true;
+		}
+	}
+	return false;
+}
+//=============================================================================
+//	eUdi::Build
+
+//-----------------------------------------------------------------------------
+// synthesize raw track (gaps, address marks, crc) from logical sectors
+//-----------------------------------------------------------------------------
+void eUdi::Build(eTrack& t)
+{
+	t.data = new byte[track_len];
+	memset(t.data, 0, track_len);
+	t.id = t.data + t.data_len;
+
+	int pos = 0;
+	t.WriteBlock(pos, 0x4e, 80);		//gap4a
+	t.WriteBlock(pos, 0, 12);			//sync
+	t.WriteBlock(pos, 0xc2, 3, true);	//iam
+	t.Write(pos++, 0xfc);
+
+	t.sectors_amount = t.logical_amount;
+	for(int i = 0; i < t.logical_amount; ++i)
+	{
+		const eSectorData& s = t.logical[i];
+		t.WriteBlock(pos, 0x4e, 40);		//gap1 50 fixme: recalculate gap1 only for non standard formats
+		t.WriteBlock(pos, 0, 12);			//sync
+		t.WriteBlock(pos, 0xa1, 3, true);	//id am
+		t.Write(pos++, 0xfe);
+		eTrack::eSector& sec = t.sectors[i];
+		sec.id = t.data + pos;
+		for(int j = 0; j < 4; ++j)
+			t.Write(pos++, s.id[j]);
+		word crc = xCrc::Crc16(0xcdb4, t.data + pos - 5, 5);
+		t.Write(pos++, crc >> 8);
+		t.Write(pos++, (byte)crc);
+
+		if(s.flags & eSectorData::F_NO_DATA)
+		{
+			sec.data = NULL;
+			continue;
+		}
+		t.WriteBlock(pos, 0x4e, 22);		//gap2
+		t.WriteBlock(pos, 0, 12);			//sync
+		t.WriteBlock(pos, 0xa1, 3, true);	//data am
+		t.Write(pos++, 0xfb);
+		sec.data = t.data + pos;
+		int len = sec.Len();
+		if(s.data)
+			memcpy(sec.data, s.data, len);
+		crc = xCrc::Crc16(0xcdb4, t.data + pos - 1, len + 1);
+		if(s.flags & eSectorData::F_CRC_ERROR)
+			crc ^= 0xffff;
+		pos += len;
+		t.Write(pos++, crc >> 8);
+		t.Write(pos++, (byte)crc);
+	}
+	if(pos > t.data_len)
+	{
+		assert(0); //track too long
+	}
+	t.WriteBlock(pos, 0x4e, t.data_len - pos - 1); //gap3
+
+	SAFE_DELETE_ARRAY(t.logical);
+	SAFE_DELETE_ARRAY(t.logical_data);
+	t.logical_amount = 0;
+}
+
 
 //=============================================================================
 //	eFdd::eFdd
@@ -180,25 +360,16 @@ static inline void SectorDataW(eUdi::eTrack::eSector* s, size_t offset, word d)
 //-----------------------------------------------------------------------------
 word eFdd::Crc(byte* src, int size) const
 {
-	dword crc = 0xcdb4;
-	while(size--)
-	{
-		crc ^= (*src++) << 8;
-		for(int i = 8; i; --i)
-		{
-			if((crc *= 2) & 0x10000)
-			{
-				crc ^= 0x1021; // bit representation of x^12+x^5+1
-			}
-		}
-	}
-	return crc;
+	return xCrc::Crc16(0xcdb4, src, size);
 }
+
 //=============================================================================
 //	eFdd::WriteSector
 //-----------------------------------------------------------------------------
 bool eFdd::WriteSector(int cyl, int side, int sec, const byte* data)
 {
+	if(!disk->Built(cyl, side))
+		return disk->WriteSector(cyl, side, sec, data);
 	eUdi::eTrack::eSector* s = GetSector(cyl, side, sec);
 	if(!s || !s->data)
 		return false;
@@ -208,14 +379,13 @@ bool eFdd::WriteSector(int cyl, int side, int sec, const byte* data)
 	return true;
 }
 //=============================================================================
-//	eFdd::GetSector
+//	FindSector
 //-----------------------------------------------------------------------------
-eUdi::eTrack::eSector* eFdd::GetSector(int cyl, int side, int sec)
+static eUdi::eTrack::eSector* FindSector(eUdi::eTrack& t, int sec)
 {
-	Seek(cyl, side);
-	for(int i = 0; i < Track().sectors_amount; ++i)
+	for(int i = 0; i < t.sectors_amount; ++i)
 	{
-		eUdi::eTrack::eSector& s = Sector(i);
+		eUdi::eTrack::eSector& s = t.sectors[i];
 		if(s.Sec() == sec && s.Len() == 256)
 		{
 			return &s;
@@ -224,6 +394,14 @@ eUdi::eTrack::eSector* eFdd::GetSector(int cyl, int side, int sec)
 	return NULL;
 }
 //=============================================================================
+//	eFdd::GetSector
+//-----------------------------------------------------------------------------
+eUdi::eTrack::eSector* eFdd::GetSector(int cyl, int side, int sec)
+{
+	Seek(cyl, side);
+	return FindSector(Track(), sec);
+}
+//=============================================================================
 //	eFdd::CreateTrd
 //-----------------------------------------------------------------------------
 void eFdd::CreateTrd()
@@ -234,17 +412,6 @@ void eFdd::CreateTrd()
 	{
 		for(int j = 0; j < disk->Sides(); ++j)
 		{
-			Seek(i, j);
-
-			int id_len = Track().data_len / 8 + ((Track().data_len & 7) ? 1 : 0);
-			memset(Track().data, 0, Track().data_len + id_len);
-
-			int pos = 0;
-			WriteBlock(pos, 0x4e, 80);		//gap4a
-			WriteBlock(pos, 0, 12);			//sync
-			WriteBlock(pos, 0xc2, 3, true);	//iam
-			Write(pos++, 0xfc);
-
 			const int max_trd_sectors = 16;
 			static const byte lv[3][max_trd_sectors] =
 			{
@@ -252,49 +419,24 @@ void eFdd::CreateTrd()
 				{ 1,9,2,10,3,11,4,12,5,13,6,14,7,15,8,16 },
 				{ 1,12,7,2,13,8,3,14,9,4,15,10,5,16,11,6 }
 			};
-			Track().sectors_amount = max_trd_sectors;
-			for(int i = 0; i < max_trd_sectors; ++i)
+			eUdi::eSectorData* s = disk->Format(i, j, max_trd_sectors);
+			for(int k = 0; k < max_trd_sectors; ++k)
 			{
-				WriteBlock(pos, 0x4e, 40);		//gap1 50 fixme: recalculate gap1 only for non standard formats
-				WriteBlock(pos, 0, 12);			//sync
-				WriteBlock(pos, 0xa1, 3, true);	//id am
-				Write(pos++, 0xfe);
-				eUdi::eTrack::eSector& sec = Sector(i);
-				sec.id = Track().data + pos;
-				Write(pos++, cyl);
-				Write(pos++, side);
-				Write(pos++, lv[trdos_interleave][i]);
-				Write(pos++, 1); //256byte
-				word crc = Crc(Track().data + pos - 5, 5);
-				Write(pos++, crc >> 8);
-				Write(pos++, (byte)crc);
-
-				WriteBlock(pos, 0x4e, 22);		//gap2
-				WriteBlock(pos, 0, 12);			//sync
-				WriteBlock(pos, 0xa1, 3, true);	//data am
-				Write(pos++, 0xfb);
-				sec.data = Track().data + pos;
-				int len = sec.Len();
-				crc = Crc(Track().data + pos - 1, len + 1);
-				pos += len;
-				Write(pos++, crc >> 8);
-				Write(pos++, (byte)crc);
+				s[k].id[0] = i;
+				s[k].id[1] = j;
+				s[k].id[2] = lv[trdos_interleave][k];
+				s[k].id[3] = 1; //256byte
 			}
-			if(pos > Track().data_len)
-			{
-				assert(0); //track too long
-			}
-			WriteBlock(pos, 0x4e, Track().data_len - pos - 1); //gap3
 		}
 	}
-	eUdi::eTrack::eSector* s = GetSector(0, 0, 9);
-	if(!s)
-		return;
-	s->data[0xe2] = 1;					// first free track
-	s->data[0xe3] = 0x16;				// 80T,DS
-	SectorDataW(s, 0xe5, 2544);			// free sec
-	s->data[0xe7] = 0x10;				// trdos flag
-	UpdateCRC(s);
+	byte s[0x100];
+	memset(s, 0, sizeof(s));
+	s[0xe2] = 1;						// first free track
+	s[0xe3] = 0x16;						// 80T,DS
+	s[0xe5] = 2544 & 0xff;				// free sec
+	s[0xe6] = 2544 >> 8;
+	s[0xe7] = 0x10;						// trdos flag
+	disk->WriteSector(0, 0, 9, s);
 }
 //=============================================================================
 //	eFdd::UpdateCRC
@@ -402,67 +544,233 @@ bool eFdd::ReadFdi(const void* _data, size_t data_size)
 	{
 		for(int j = 0; j < disk->Sides(); ++j)
 		{
-			Seek(i, j);
-
-			int id_len = Track().data_len / 8 + ((Track().data_len & 7) ? 1 : 0);
-			memset(Track().data, 0, Track().data_len + id_len);
-
-			int pos = 0;
-			WriteBlock(pos, 0x4e, 80);		//gap4a
-			WriteBlock(pos, 0, 12);			//sync
-			WriteBlock(pos, 0xc2, 3, true);	//iam
-			Write(pos++, 0xfc);
-
 			const byte* t0 = dat + Dword(trk);
 			int ns = trk[6];
-			Track().sectors_amount = ns;
+			eUdi::eSectorData* s = disk->Format(i, j, ns);
 			trk += 7;
-			for(int i = 0; i < ns; ++i)
+			// SectorData() sizes track data by all ids, so they're set first
+			for(int k = 0; k < ns; ++k)
+			{
+				memcpy(s[k].id, trk + k*7, 4);
+			}
+			for(int k = 0; k < ns; ++k)
 			{
-				WriteBlock(pos, 0x4e, 40);		//gap1 50 fixme: recalculate gap1 only for non standard formats
-				WriteBlock(pos, 0, 12);			//sync
-				WriteBlock(pos, 0xa1, 3, true);	//id am
-				Write(pos++, 0xfe);
-				eUdi::eTrack::eSector& sec = Sector(i);
-				sec.id = Track().data + pos;
-				Write(pos++, trk[0]);
-				Write(pos++, trk[1]);
-				Write(pos++, trk[2]);
-				Write(pos++, trk[3]);
-				word crc = Crc(Track().data + pos - 5, 5);
-				Write(pos++, crc >> 8);
-				Write(pos++, (byte)crc);
-
 				if(trk[4] & 0x40)
 				{
-					sec.data = NULL;
+					s[k].flags = eUdi::eSectorData::F_NO_DATA;
 				}
 				else
 				{
 					const byte* data = t0 + Word(trk+5);
 					if(data + 128 > buf + data_size)
 						return false;
-					WriteBlock(pos, 0x4e, 22);		//gap2
-					WriteBlock(pos, 0, 12);			//sync
-					WriteBlock(pos, 0xa1, 3, true);	//data am
-					Write(pos++, 0xfb);
-					sec.data = Track().data + pos;
-					int len = sec.Len();
-					memcpy(sec.data, data, len);
-					crc = Crc(Track().data + pos - 1, len + 1);
 					if(!(trk[4] & (1<<(trk[3] & 3))))
-						crc ^= 0xffff;
-					pos += len;
-					Write(pos++, crc >> 8);
-					Write(pos++, (byte)crc);
+						s[k].flags = eUdi::eSectorData::F_CRC_ERROR;
+					disk->SectorData(i, j, k, data);
 				}
 				trk += 7;
 			}
-			if(pos > Track().data_len)
+
+		}
+	}
+	return true;
+}
+//=============================================================================
+//	eFdd::Store
+//-----------------------------------------------------------------------------
+bool eFdd::Store(const char* type, xIo::eFileWrite* w, bool dirty_only)
+{
+	if(!disk)
+		return false;
+	bool ok = false;
+	if(!strcmp(type, "trd"))
+		ok = StoreTrd(w, dirty_only);
+	else if(!strcmp(type, "scl"))
+		ok = StoreScl(w);
+	else if(!strcmp(type, "fdi"))
+		ok = StoreFdi(w);
+	if(ok)
+	{
+		for(int i = 0; i < disk->Cyls(); ++i)
+		{
+			for(int j = 0; j < disk->Sides(); ++j)
+			{
+				if(disk->Built(i, j))
+					disk->Track(i, j).dirty = 0;
+			}
+		}
+	}
+	return ok;
+}
+//=============================================================================
+//	eFdd::StoreTrd
+//-----------------------------------------------------------------------------
+bool eFdd::StoreTrd(xIo::eFileWrite* w, bool dirty_only)
+{
+	const int trd_cyls = 80;
+	for(int i = 0; i < Min(disk->Cyls(), trd_cyls); ++i)
+	{
+		for(int j = 0; j < 2; ++j)
+		{
+			bool present = j < disk->Sides();
+			// only built tracks may be modified, others are stored without building them
+			if(dirty_only && (!present || !disk->Built(i, j) || !disk->Track(i, j).dirty))
+				continue;
+			for(int sec = 1; sec <= 16; ++sec)
+			{
+				const byte* data = NULL;
+				if(dirty_only)
+				{
+					eUdi::eTrack& t = disk->Track(i, j);
+					eUdi::eTrack::eSector* s = FindSector(t, sec);
+					if(!s || !(t.dirty & (1 << (s - t.sectors))))
+						continue;
+					data = s->data;
+				}
+				else if(present)
+					data = disk->ReadSector(i, j, sec);
+				size_t offset = i * 0x2000 + j * 0x1000 + (sec - 1) * 0x100;
+				w->Add(offset, data ? data : zero_sector, 0x100);
+			}
+		}
+	}
+	return true;
+}
+//=============================================================================
+//	eFdd::StoreScl
+//-----------------------------------------------------------------------------
+bool eFdd::StoreScl(xIo::eFileWrite* w)
+{
+	const byte* files[128];
+	int files_amount = 0;
+	for(int sec = 1; sec <= 8; ++sec)
+	{
+		const byte* data = disk->ReadSector(0, 0, sec);
+		if(!data)
+			return false;
+		int i = 0;
+		for(; i < 0x100; i += 0x10)
+		{
+			const byte* f = data + i;
+			if(!f[0])
+				break;
+			if(f[0] != 1) // deleted
+				files[files_amount++] = f;
+		}
+		if(i < 0x100)
+			break;
+	}
+
+	dword sum = 0;
+	size_t offset = 0;
+	byte hdr[9];
+	memcpy(hdr, "SINCLAIR", 8);
+	hdr[8] = files_amount;
+	w->Add(offset, hdr, sizeof(hdr));
+	offset += sizeof(hdr);
+	for(size_t i = 0; i < sizeof(hdr); ++i)
+		sum += hdr[i];
+	for(int i = 0; i < files_amount; ++i)
+	{
+		w->Add(offset, files[i], 14);
+		offset += 14;
+		for(int j = 0; j < 14; ++j)
+			sum += files[i][j];
+	}
+	for(int i = 0; i < files_amount; ++i)
+	{
+		int pos = files[i][15] * 16 + files[i][14];
+		for(int k = 0; k < files[i][13]; ++k, ++pos)
+		{
+			int cyl = pos / 32;
+			int side = (pos / 16) & 1;
+			if(cyl >= disk->Cyls() || side >= disk->Sides())
+				return false;
+			const byte* data = disk->ReadSector(cyl, side, (pos & 0x0f) + 1);
+			if(!data)
+				return false;
+			w->Add(offset, data, 0x100);
+			offset += 0x100;
+			for(int j = 0; j < 0x100; ++j)
+				sum += data[j];
+		}
+	}
+	byte crc[4] = { byte(sum), byte(sum >> 8), byte(sum >> 16), byte(sum >> 24) };
+	w->Add(offset, crc, sizeof(crc));
+	return true;
+}
+//=============================================================================
+//	eFdd::StoreFdi
+//-----------------------------------------------------------------------------
+bool eFdd::StoreFdi(xIo::eFileWrite* w)
+{
+	int headers_size = 0;
+	for(int i = 0; i < disk->Cyls(); ++i)
+	{
+		for(int j = 0; j < disk->Sides(); ++j)
+		{
+			const eUdi::eTrack& t = disk->Kept(i, j);
+			headers_size += 7 + (t.logical ? t.logical_amount : t.sectors_amount) * 7;
+		}
+	}
+	const int text_offset = 0x0E + headers_size;
+	const int data_offset = text_offset + 1;
+	byte hdr[0x0E] =
+	{
+		'F', 'D', 'I', write_protect,
+		byte(disk->Cyls()), 0, byte(disk->Sides()), 0,
+		byte(text_offset), byte(text_offset >> 8),
+		byte(data_offset), byte(data_offset >> 8),
+		0, 0
+	};
+	w->Add(0, hdr, sizeof(hdr));
+	static const byte text = 0;
+	w->Add(text_offset, &text, 1);
+
+	size_t hdr_pos = sizeof(hdr);
+	dword track_pos = 0;
+	for(int i = 0; i < disk->Cyls(); ++i)
+	{
+		for(int j = 0; j < disk->Sides(); ++j)
+		{
+			// tracks not built yet are stored from logical sectors
+			const eUdi::eTrack& t = disk->Kept(i, j);
+			int sectors_amount = t.logical ? t.logical_amount : t.sectors_amount;
+			byte trk[7] = { byte(track_pos), byte(track_pos >> 8), byte(track_pos >> 16), byte(track_pos >> 24), 0, 0, byte(sectors_amount) };
+			w->Add(hdr_pos, trk, sizeof(trk));
+			hdr_pos += sizeof(trk);
+			word sec_pos = 0;
+			for(int k = 0; k < sectors_amount; ++k)
 			{
-				assert(0); //track too long
+				const byte* id;
+				const byte* data;
+				bool crc_ok;
+				if(t.logical)
+				{
+					const eUdi::eSectorData& s = t.logical[k];
+					id = s.id;
+					data = (s.flags & eUdi::eSectorData::F_NO_DATA) ? NULL : (s.data ? s.data : zero_sector);
+					crc_ok = !(s.flags & eUdi::eSectorData::F_CRC_ERROR);
+				}
+				else
+				{
+					const eUdi::eTrack::eSector& s = t.sectors[k];
+					id = s.id;
+					data = s.data;
+					crc_ok = data && Crc(s.data - 1, s.Len() + 1) == s.DataCrc();
+				}
+				byte sec[7] = { id[0], id[1], id[2], id[3], 0x40, byte(sec_pos), byte(sec_pos >> 8) };
+				if(data)
+				{
+					int len = 128 << (id[3] & 3);
+					sec[4] = crc_ok ? 1 << (id[3] & 3) : 0;
+					w->Add(data_offset + track_pos + sec_pos, data, len);
+					sec_pos += len;
+				}
+				w->Add(hdr_pos, sec, sizeof(sec));
+				hdr_pos += sizeof(sec);
 			}
-			WriteBlock(pos, 0x4e, Track().data_len - pos - 1); //gap3
+			track_pos += sec_pos;
 		}
 	}
 	return true;
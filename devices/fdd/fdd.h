@@ -23,6 +23,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #pragma once
 
+namespace xIo
+{
+class eFileWrite;
+}
+//namespace xIo
+
 //*****************************************************************************
 //	eUdi
 //-----------------------------------------------------------------------------
@@ -30,16 +36,34 @@ class eUdi
 {
 public:
 	eUdi(int cyls, int sides);
-	~eUdi() { SAFE_DELETE_ARRAY(raw); }
+	~eUdi();
 	int Cyls() const	{ return cyls; }
 	int Sides() const	{ return sides; }
 
 	enum { MAX_CYL = 86, MAX_SIDE = 2, MAX_SEC = 32 };
+	// logical sector, kept until raw track data requested
+	struct eSectorData
+	{
+		eSectorData() : flags(0), data(NULL) { memset(id, 0, sizeof(id)); }
+		enum eFlag { F_NO_DATA = 0x01, F_CRC_ERROR = 0x02 };
+		int Len() const		{ return 128 << (id[3] & 3); }
+		byte	id[4];	// cyl, side, sec, len
+		byte	flags;
+		byte*	data;	// NULL if filled with zeros
+	};
 	struct eTrack
 	{
-		eTrack() : data_len(6400), data(NULL), id(NULL), sectors_amount(0) {}
+		eTrack() : data_len(6400), data(NULL), id(NULL), sectors_amount(0)
+			, dirty(0), logical(NULL), logical_amount(0), logical_data(NULL) {}
 		bool Marker(int pos) const;
 		void Write(int pos, byte v, bool marker = false);
+		void WriteBlock(int& pos, byte v, int amount, bool marker = false)
+		{
+			for(int i = 0; i < amount; ++i)
+			{
+				Write(pos++, v, marker);
+			}
+		}
 		void Update(); //on raw changed
 
 		int		data_len;
@@ -61,16 +85,43 @@ public:
 		};
 		eSector	sectors[MAX_SEC];
 		int		sectors_amount;
+
+		void Modified(const eSector* s) { dirty |= 1 << (s - sectors); }
+		void Modified() { dirty = ~0; } // whole track rewritten
+		dword	dirty;	// modified sectors mask, by index in sectors[]
+
+		eSectorData* logical;
+		int		logical_amount;
+		byte*	logical_data;
 	};
-	eTrack& Track(int cyl, int side) { return tracks[cyl][side]; }
+	eTrack& Track(int cyl, int side)
+	{
+		eTrack& t = tracks[cyl][side];
+		if(!t.data && t.logical)
+			Build(t);
+		return t;
+	}
+	bool Built(int cyl, int side) const { return !tracks[cyl][side].logical; }
+	const eTrack& Kept(int cyl, int side) const { return tracks[cyl][side]; } // not built, logical sectors if !Built()
+	const byte* ReadSector(int cyl, int side, int sec) const; // 256 byte one, NULL if no data
+	eSectorData* Format(int cyl, int side, int sectors_amount);
+	bool WriteSector(int cyl, int side, int sec, const byte* data);
+	void SectorData(int cyl, int side, int sec_idx, const byte* data); // all ids of track must be set
+
+	bool Dirty() const;
+
+
+protected:
+	void Build(eTrack& t);
 
 protected:
 	int		cyls;
 	int		sides;
 	eTrack	tracks[MAX_CYL][MAX_SIDE];
-	byte*	raw;
+	int		track_len;
 };
 
+
 //*****************************************************************************
 //	eFdd
 //-----------------------------------------------------------------------------
@@ -93,24 +144,23 @@ public:
 	bool WriteProtect() const	{ return write_protect; }
 	bool Open(const char* type, const void* data, size_t data_size);
 	bool BootExist();
+	bool Dirty() const			{ return disk && disk->Dirty(); }
+	bool Store(const char* type, xIo::eFileWrite* w, bool dirty_only);
 
 protected:
 	word Crc(byte* src, int size) const;
 	eUdi::eTrack::eSector* GetSector(int cyl, int side, int sec);
 	bool WriteSector(int cyl, int side, int sec, const byte* data);
-	void WriteBlock(int& pos, byte v, int amount, bool marker = false)
-	{
-		for(int i = 0; i < amount; ++i)
-		{
-			Track().Write(pos++, v, marker);
-		}
-	}
 	void CreateTrd();
 	bool AddFile(const byte* hdr, const byte* data);
 	bool ReadScl(const void* data, size_t data_size);
 	bool ReadTrd(const void* data, size_t data_size);
 	bool ReadFdi(const void* data, size_t data_size);
 	void UpdateCRC(eUdi::eTrack::eSector* s) const;
+	bool StoreTrd(xIo::eFileWrite* w, bool dirty_only);
+	bool StoreScl(xIo::eFileWrite* w);
+	bool StoreFdi(xIo::eFileWrite* w);
+
 
 protected:
 	qword	motor;	// 0 - not spinning, >0 - time when it'll stop
@@ -20,17 +20,17 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "../../speccy.h"
 #include "wd1793.h"
 #include "../memory.h"
+#include "../../z80/z80.h"
+#include "../../tools/crc16.h"
 
 const int Z80FQ = 3500000;		// todo: #define as (conf.frame*conf.intfq)
 const int FDD_RPS = 5;			// rotation speed
 const int MAX_PHYS_CYL = 86;	// don't seek over it
 
-const bool wd93_nodelay = false;
-
 //=============================================================================
 //	eWD1793::eWD1793
 //-----------------------------------------------------------------------------
-eWD1793::eWD1793(eSpeccy* _speccy, eRom* _rom) : speccy(_speccy), rom(_rom)
+eWD1793::eWD1793(eSpeccy* _speccy, eRom* _rom) : speccy(_speccy), rom(_rom), fast(false)
 	, next(0), tshift(0), state(S_IDLE), state_next(S_IDLE), cmd(0), data(0)
 	, track(0), side(0), sector(0), direction(0), rqs(R_NONE), status(0)
 	, system(0), end_waiting_am(0), found_sec(NULL), rwptr(0), rwlen(0), crc(0), start_crc(-1)
@@ -73,33 +73,37 @@ bool eWD1793::BootExist(int drive)
 	return fdds[drive].BootExist();
 }
 //=============================================================================
+//	eWD1793::Dirty
+//-----------------------------------------------------------------------------
+bool eWD1793::Dirty(int drive) const
+{
+	assert(drive >= 0 && drive < FDD_COUNT);
+	return fdds[drive].Dirty();
+}
+//=============================================================================
+//	eWD1793::Store
+//-----------------------------------------------------------------------------
+bool eWD1793::Store(int drive, const char* type, xIo::eFileWrite* w, bool dirty_only)
+{
+	assert(drive >= 0 && drive < FDD_COUNT);
+	return fdds[drive].Store(type, w, dirty_only);
+}
+//=============================================================================
 //	eWD1793::Crc
 //-----------------------------------------------------------------------------
 const word crc_initial = 0xcdb4;
 word eWD1793::Crc(byte* src, int size) const
 {
-	word crc = crc_initial;
-	while(size--)
-	{
-		crc = Crc(*src++, crc);
-	}
-	return crc;
+	return xCrc::Crc16(crc_initial, src, size);
 }
 //=============================================================================
 //	eWD1793::Crc
 //-----------------------------------------------------------------------------
 word eWD1793::Crc(byte v, word prev_crc = crc_initial) const
 {
-	dword crc = prev_crc ^ (v << 8);
-	for(int i = 8; i; --i)
-	{
-		if((crc <<= 1) & 0x10000)
-		{
-			crc ^= 0x1021; // bit representation of x^12+x^5+1
-		}
-	}
-	return crc;
+	return xCrc::Crc16(prev_crc, v);
 }
+
 //=============================================================================
 //	eWD1793::Process
 //-----------------------------------------------------------------------------
@@ -143,7 +147,7 @@ void eWD1793::Process(int tact)
 			state = state_next;
 			break;
 		case S_DELAY_BEFORE_CMD:
-			if(!wd93_nodelay && (cmd & CB_DELAY))
+			if(!fast && (cmd & CB_DELAY))
 			{
 				next += (Z80FQ*15/1000); // 15ms delay
 			}
@@ -270,7 +274,7 @@ void eWD1793::Process(int tact)
 				rwlen--;
 				rqs = R_DRQ;
 				status |= ST_DRQ;
-				if(!wd93_nodelay)
+				if(!fast)
 				{
 					next += fdd->TSByte();
 				}
@@ -310,6 +314,7 @@ void eWD1793::Process(int tact)
 				state = S_IDLE;
 				break;
 			}
+			fdd->Track().Modified(found_sec);
 			rwptr = found_sec->id + 6 + 22 - fdd->Track().data;
 			for(rwlen = 0; rwlen < 12; rwlen++)
 			{
@@ -341,7 +346,7 @@ void eWD1793::Process(int tact)
 			}
 			if(rwlen)
 			{
-				if(!wd93_nodelay)
+				if(!fast)
 				{
 					next += fdd->TSByte();
 				}
@@ -419,7 +424,7 @@ void eWD1793::Process(int tact)
 				rwlen--;
 				if(rwlen > 0)
 				{
-					if(!wd93_nodelay)
+					if(!fast)
 					{
 						next += fdd->TSByte();
 					}
@@ -430,7 +435,9 @@ void eWD1793::Process(int tact)
 					break;
 				}
 				fdd->Track().Update();
+				fdd->Track().Modified();
 				state = S_IDLE;
+
 				break;
 			}
 		case S_TYPE1_CMD:
@@ -447,7 +454,7 @@ void eWD1793::Process(int tact)
 				if(cmd & 0x40) direction = (cmd & CB_SEEK_DIR) ? -1 : 1;
 				state_next = S_STEP;
 			}
-			if(!wd93_nodelay)
+			if(!fast)
 			{
 				next += 1 * Z80FQ / 1000;
 			}
@@ -476,7 +483,7 @@ void eWD1793::Process(int tact)
 				}
 				fdd->Cyl(cyl);
 				static const dword steps[] = { 6, 12, 20, 30 };
-				if(!wd93_nodelay)
+				if(!fast)
 				{
 					next += steps[cmd & CB_SEEK_RATE] * Z80FQ / 1000;
 				}
@@ -543,7 +550,7 @@ void eWD1793::ReadFirstByte()
 //-----------------------------------------------------------------------------
 void eWD1793::FindMarker()
 {
-	if(wd93_nodelay && fdd->Cyl() != track)
+	if(fast && fdd->Cyl() != track)
 	{
 		fdd->Cyl(track);
 	}
@@ -566,7 +573,7 @@ void eWD1793::FindMarker()
 			}
 		}
 		wait = found_sec ? wait * fdd->TSByte() : 10 * Z80FQ/FDD_RPS;
-		if(wd93_nodelay && found_sec)
+		if(fast && found_sec)
 		{
 			// adjust tshift, that id appares right under head
 			dword pos = found_sec->id - fdd->Track().data + 2;
@@ -589,14 +596,15 @@ void eWD1793::FindMarker()
 bool eWD1793::Ready()
 {
 	// fdc is too fast in no-delay mode, wait until cpu handles DRQ, but not more 'end_waiting_am'
-	if(!wd93_nodelay || !(rqs & R_DRQ))
+	if(!fast || !(rqs & R_DRQ))
 		return true;
 	if(next > end_waiting_am)
 		return true;
-	state = S_WAIT;
 	state_next = state;
+	state = S_WAIT;
 	next += fdd->TSByte();
 	return false;
+
 }
 //=============================================================================
 //	eWD1793::GetIndex
@@ -605,7 +613,7 @@ void eWD1793::GetIndex()
 {
 	dword trlen = fdd->Track().data_len * fdd->TSByte();
 	dword ticks = (dword)((next + tshift) % trlen);
-	if(!wd93_nodelay)
+	if(!fast)
 	{
 		next += (trlen - ticks);
 	}
@@ -613,32 +621,123 @@ void eWD1793::GetIndex()
 	rwlen = fdd->Track().data_len;
 	state = S_WAIT;
 }
+namespace xZ80
+{
+
+//*****************************************************************************
+//	eZ80_FastDisk
+//-----------------------------------------------------------------------------
+class eZ80_FastDisk : public eZ80
+{
+public:
+	bool InLoop(word addr, const byte* code, int size) const
+	{
+		if((pc & 0xffff) != dword(addr + 2)) // just after in a,(#ff)
+			return false;
+		for(int i = 0; i < size; ++i)
+		{
+			if(memory->Read(addr + i) != code[i])
+				return false;
+		}
+		return true;
+	}
+	void Ini(byte v) { memory->Write(hl, v); ++hl; --b; }
+	byte Outi() { byte v = memory->Read(hl); ++hl; --b; return v; }
+};
+
+}
+//namespace xZ80
+
+// TR-DOS (5.04T, 5.13f) sector data transfer loops
+// in a,(#ff):and #c0:jr z,$-4:ret m:ini(outi):jr $-11
+static const word trdos_read_loop_addr = 0x3fe5;
+static const byte trdos_read_loop[] = { 0xdb, 0xff, 0xe6, 0xc0, 0x28, 0xfa, 0xf8, 0xed, 0xa2, 0x18, 0xf5 };
+static const word trdos_write_loop_addr = 0x3fca;
+static const byte trdos_write_loop[] = { 0xdb, 0xff, 0xe6, 0xc0, 0x28, 0xfa, 0xf8, 0xed, 0xa3, 0x18, 0xf5 };
+
+//=============================================================================
+//	eWD1793::FastTransfer
+//-----------------------------------------------------------------------------
+// move whole sector between disk and memory when TR-DOS waits for DRQ
+// in its transfer loop, then finish command at once
+//-----------------------------------------------------------------------------
+void eWD1793::FastTransfer(int tact)
+{
+	if(state != S_WAIT)
+		return;
+	xZ80::eZ80_FastDisk* cpu = (xZ80::eZ80_FastDisk*)speccy->CPU();
+	if(state_next == S_READ && rwlen &&
+		cpu->InLoop(trdos_read_loop_addr, trdos_read_loop, sizeof(trdos_read_loop)))
+	{
+		if(rqs & R_DRQ)
+		{
+			cpu->Ini(data);
+			rqs &= ~R_DRQ;
+			status &= ~ST_DRQ;
+		}
+		Load();
+		const byte* src = fdd->Track().data + rwptr;
+		crc = xCrc::Crc16(crc, src, rwlen);
+		for(; rwlen; --rwlen)
+		{
+			cpu->Ini(fdd->Track().data[rwptr++]);
+		}
+		state = S_READ;
+		Process(tact);
+	}
+	else if(state_next == S_WRITE && (rqs & R_DRQ) && rwlen > 1 &&
+		cpu->InLoop(trdos_write_loop_addr, trdos_write_loop, sizeof(trdos_write_loop)))
+	{
+		Load();
+		for(; rwlen > 1; --rwlen) // last byte written by cpu finishes command
+		{
+			byte v = cpu->Outi();
+			fdd->Write(rwptr++, v);
+			crc = Crc(v, crc);
+			if(rwptr == fdd->Track().data_len)
+			{
+				rwptr = 0;
+			}
+		}
+	}
+}
 //=============================================================================
 //	eWD1793::Load
+
 //-----------------------------------------------------------------------------
 void eWD1793::Load()
 {
 	fdd->Seek(fdd->Cyl(), side);
 }
 //=============================================================================
-//	eWD1793::IoRead
+//	eWD1793::IoReadDecode
 //-----------------------------------------------------------------------------
-bool eWD1793::IoRead(word port) const
+int eWD1793::IoReadDecode(eIoDecode* d) const
 {
-	if((port&0x1f) != 0x1f)
-		return false;
-	byte p = (byte)port;
-	return p == 0x1f || p == 0x3f || p == 0x5f || p == 0x7f || p & 0x80;
+	static const eIoDecode ports[] =
+	{
+		{ 0x00ff, 0x001f, false },	// #1f
+		{ 0x00ff, 0x003f, false },	// #3f
+		{ 0x00ff, 0x005f, false },	// #5f
+		{ 0x00ff, 0x007f, false },	// #7f
+		{ 0x009f, 0x009f, false },	// #ff
+	};
+	return IoDecode(d, ports, 5);
 }
 //=============================================================================
-//	eWD1793::IoWrite
+//	eWD1793::IoWriteDecode
 //-----------------------------------------------------------------------------
-bool eWD1793::IoWrite(word port) const
+int eWD1793::IoWriteDecode(eIoDecode* d) const
 {
-	if((port&0x1f) != 0x1f)
-		return false;
-	byte p = (byte)port;
-	return p == 0x1f || p == 0x3f || p == 0x5f || p == 0x7f || p & 0x80;
+	static const eIoDecode ports[] =
+	{
+		{ 0x00ff, 0x001f, false },	// #1f
+		{ 0x00ff, 0x003f, false },	// #3f
+		{ 0x00ff, 0x005f, false },	// #5f
+		{ 0x00ff, 0x007f, false },	// #7f
+		{ 0x009f, 0x009f, false },	// #ff
+	};
+	return IoDecode(d, ports, 5);
 }
 //=============================================================================
 //	eWD1793::IoRead
@@ -650,7 +749,12 @@ void eWD1793::IoRead(word port, byte* v, int tact)
 	Process(tact);
 	*v = 0xff;
 	byte p = (byte)port;
-	if(p & 0x80)		*v = rqs | 0x3F;
+	if(p & 0x80)
+	{
+		if(fast)
+			FastTransfer(tact);
+		*v = rqs | 0x3F;
+	}
 	else if(p == 0x1f)
 	{
 		rqs &= ~R_INTRQ;
@@ -697,7 +801,7 @@ void eWD1793::IoWrite(word port, byte v, int tact)
 				rqs = R_INTRQ;
 				return;
 			}
-			if(fdd->Motor() || wd93_nodelay) //continue disk spinning
+			if(fdd->Motor() || fast) //continue disk spinning
 			{
 				fdd->Motor(next + 2*Z80FQ);
 			}
@@ -35,12 +35,17 @@ class eWD1793 : public eDevice
 public:
 	eWD1793(eSpeccy* _speccy, eRom* _rom);
 	virtual void Init();
-	virtual bool IoRead(word port) const;
-	virtual bool IoWrite(word port) const;
+	virtual int IoReadDecode(eIoDecode* d) const;
+	virtual int IoWriteDecode(eIoDecode* d) const;
 	virtual void IoRead(word port, byte* v, int tact);
 	virtual void IoWrite(word port, byte v, int tact);
 	bool Open(const char* type, int drive, const void* data, size_t data_size);
 	bool BootExist(int drive);
+	bool Dirty(int drive) const;
+	bool Store(int drive, const char* type, xIo::eFileWrite* w, bool dirty_only = false);
+	bool Busy() const { return state != S_IDLE; }
+	void FastMode(bool on) { fast = on; }
+
 
 	static eDeviceId Id() { return D_WD1793; }
 	virtual dword IoNeed() const { return ION_WRITE|ION_READ; }
@@ -51,6 +56,7 @@ protected:
 	bool	Ready();
 	void	Load();
 	void	GetIndex();
+	void	FastTransfer(int tact);
 	word	Crc(byte* src, int size) const;
 	word	Crc(byte v, word prev) const;
 
@@ -95,6 +101,8 @@ protected:
 protected:
 	eSpeccy* speccy;
 	eRom*	rom;
+	bool	fast;				// no delays & whole sector transfers in TR-DOS
+
 
 	qword	next;
 	int		tshift;
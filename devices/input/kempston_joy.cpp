@@ -22,19 +22,21 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 void eKempstonJoy::Init() { Reset(); }
 void eKempstonJoy::Reset() { state = 0; }
 
-//=============================================================================
-//	eKempstonJoy::IoRead
-//-----------------------------------------------------------------------------
-bool eKempstonJoy::IoRead(word port) const
-{
-	if(port&0x20)
-		return false;
-	// skip kempston mouse ports
-	port |= 0xfa00; // A13,A15 not used in decoding
-	if((port == 0xfadf || port == 0xfbdf || port == 0xffdf))
-		return false;
-	return true;
-}
+//=============================================================================
+//	eKempstonJoy::IoReadDecode
+//-----------------------------------------------------------------------------
+int eKempstonJoy::IoReadDecode(eIoDecode* d) const
+{
+	static const eIoDecode ports[] =
+	{
+		{ 0x0020, 0x0000, false },	// #1f
+		// skip kempston mouse ports (A13, A15 not used in decoding)
+		{ 0x05ff, 0x00df, true },	// #fadf
+		{ 0x05ff, 0x01df, true },	// #fbdf
+		{ 0x05ff, 0x05df, true },	// #ffdf
+	};
+	return IoDecode(d, ports, 4);
+}
 //=============================================================================
 //	eKempstonJoy::IoRead
 //-----------------------------------------------------------------------------
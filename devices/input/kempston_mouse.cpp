@@ -30,16 +30,18 @@ void eKempstonMouse::Reset()
     buttons = 0xFF;
 }
 //=============================================================================
-//	eKempstonMouse::IoRead
+//	eKempstonMouse::IoReadDecode
 //-----------------------------------------------------------------------------
-bool eKempstonMouse::IoRead(word port) const
+int eKempstonMouse::IoReadDecode(eIoDecode* d) const
 {
-	if(port&0x20)
-		return false;
-	port |= 0xfa00; // A13,A15 not used in decoding
-	if(port != 0xfadf && port != 0xfbdf && port != 0xffdf)
-		return false;
-	return true;
+	// A13, A15 not used in decoding
+	static const eIoDecode ports[] =
+	{
+		{ 0x05ff, 0x00df, false },	// #fadf
+		{ 0x05ff, 0x01df, false },	// #fbdf
+		{ 0x05ff, 0x05df, false },	// #ffdf
+	};
+	return IoDecode(d, ports, 3);
 }
 //=============================================================================
 //	eKempstonMouse::IoRead
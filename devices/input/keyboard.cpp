@@ -34,11 +34,12 @@ void eKeyboard::Reset()
 	memset(kbd, 0xff, sizeof(kbd));
 }
 //=============================================================================
-//	eKeyboard::IoRead
+//	eKeyboard::IoReadDecode
 //-----------------------------------------------------------------------------
-bool eKeyboard::IoRead(word port) const
+int eKeyboard::IoReadDecode(eIoDecode* d) const
 {
-	return !(port&1);
+	static const eIoDecode ports[] = { { 0x0001, 0x0000, false } };	// #fe
+	return IoDecode(d, ports, 1);
 }
 //=============================================================================
 //	eKeyboard::IoRead
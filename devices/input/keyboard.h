@@ -28,7 +28,7 @@ class eKeyboard : public eDevice
 public:
 	virtual void Init();
 	virtual void Reset();
-	virtual bool IoRead(word port) const;
+	virtual int IoReadDecode(eIoDecode* d) const;
 	virtual void IoRead(word port, byte* v, int tact);
 	void OnKey(char key, bool down, bool shift, bool ctrl, bool alt);
 
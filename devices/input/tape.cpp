@@ -22,6 +22,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "../memory.h"
 #include "tape.h"
 #include "../../platform/platform.h"
+#include "../../platform/io.h"
 
 //=============================================================================
 //	eTape::Init
@@ -35,6 +36,9 @@ void eTape::Init()
 	tape_image = NULL;
 	tape_imagesize = 0;
 
+	tape_file = NULL;
+	instant = false;
+
 	tapeinfo = NULL;
 	tape_infosize = 0;
 
@@ -49,6 +53,24 @@ void eTape::Reset()
 	ResetTape();
 }
 //=============================================================================
+//	eTape::FrameStart
+//-----------------------------------------------------------------------------
+void eTape::FrameStart(dword tacts)
+{
+	eInherited::FrameStart(tacts);
+	CacheEdge();
+}
+//=============================================================================
+//	eTape::FrameEnd
+//-----------------------------------------------------------------------------
+void eTape::FrameEnd(dword tacts)
+{
+	edges.Flush(this);
+	if(tape.stop)
+		StopTape();
+	eInherited::FrameEnd(tacts);
+}
+//=============================================================================
 //	eTape::Start
 //-----------------------------------------------------------------------------
 void eTape::Start()
@@ -77,11 +99,12 @@ bool eTape::Inserted() const
 	return tape_image != NULL;
 }
 //=============================================================================
-//	eTape::IoRead
+//	eTape::IoReadDecode
 //-----------------------------------------------------------------------------
-bool eTape::IoRead(word port) const
+int eTape::IoReadDecode(eIoDecode* d) const
 {
-	return !(port&1);
+	static const eIoDecode ports[] = { { 0x0001, 0x0000, false } };	// #fe
+	return IoDecode(d, ports, 1);
 }
 //=============================================================================
 //	eTape::IoRead
@@ -147,6 +170,8 @@ void eTape::StopTape()
 	tape.play_pointer = 0;
 	tape.edge_change = 0x7FFFFFFFFFFFFFFFLL;
 	tape.tape_bit = -1;
+	tape.stop = false;
+	CacheEdge();
 	speccy->CPU()->HandlerStep(NULL);
 }
 //=============================================================================
@@ -158,6 +183,8 @@ void eTape::ResetTape()
 	tape.play_pointer = 0;
 	tape.edge_change = 0x7FFFFFFFFFFFFFFFLL;
 	tape.tape_bit = -1;
+	tape.stop = false;
+	CacheEdge();
 	speccy->CPU()->HandlerStep(NULL);
 }
 //=============================================================================
@@ -171,6 +198,8 @@ void eTape::StartTape()
 	tape.end_of_tape = tape_image + tape_imagesize;
 	tape.edge_change = speccy->T();
 	tape.tape_bit = -1;
+	tape.stop = false;
+	CacheEdge();
 //	speccy->CPU()->FastEmul(FastTapeEmul);
 }
 //=============================================================================
@@ -183,6 +212,11 @@ void eTape::CloseTape()
 		free(tape_image);
 		tape_image = 0;
 	}
+	if(tape_file)
+	{
+		tape_file->Release();
+		tape_file = NULL;
+	}
 	if(tapeinfo)
 	{
 		free(tapeinfo);
@@ -193,6 +227,8 @@ void eTape::CloseTape()
 	tape_err = max_pulses = tape_imagesize = tape_infosize = 0;
 	tape.edge_change = 0x7FFFFFFFFFFFFFFFLL;
 	tape.tape_bit = -1;
+	tape.stop = false;
+	CacheEdge();
 }
 
 #define align_by(a,b) (((dword)(a) + ((b)-1)) & ~((b)-1))
@@ -210,6 +246,16 @@ void eTape::Reserve(dword datasize)
 		tape_image = (byte*)realloc(tape_image, newsize);
 }
 //=============================================================================
+//	eTape::KeepBlock
+//-----------------------------------------------------------------------------
+void eTape::KeepBlock(dword pos, dword size, dword pilot_len)
+{
+	TAPEINFO& ti = tapeinfo[tape_infosize - 1];
+	ti.block_pos = pos;
+	ti.block_size = size;
+	ti.block_pulses = tape_imagesize + pilot_len + 2; // pilot & sync pulses
+}
+//=============================================================================
 //	eTape::MakeBlock
 //-----------------------------------------------------------------------------
 void eTape::MakeBlock(const byte* data, dword size, dword pilot_t, dword s1_t,
@@ -270,6 +316,7 @@ void eTape::AllocInfocell()
 	tapeinfo = (TAPEINFO*)realloc(tapeinfo, (tape_infosize + 1)
 			* sizeof(TAPEINFO));
 	tapeinfo[tape_infosize].pos = tape_imagesize;
+	tapeinfo[tape_infosize].block_size = 0;
 	appendable = 0;
 }
 //=============================================================================
@@ -288,15 +335,19 @@ void eTape::NamedCell(const void* nm, dword sz)
 //=============================================================================
 //	eTape::Open
 //-----------------------------------------------------------------------------
-bool eTape::Open(const char* type, const void* data, size_t data_size)
+bool eTape::Open(const char* type, xIo::eFileData* file)
 {
+	bool ok = false;
 	if(!strcmp(type, "tap"))
-		return ParseTAP(data, data_size);
+		ok = ParseTAP(file->Data(), file->Size());
 	else if(!strcmp(type, "csw"))
-		return ParseCSW(data, data_size);
+		ok = ParseCSW(file->Data(), file->Size());
 	else if(!strcmp(type, "tzx"))
-		return ParseTZX(data, data_size);
-	return false;
+		ok = ParseTZX(file->Data(), file->Size());
+	else
+		return false;
+	tape_file = file->AddRef(); // parsed blocks refer to it
+	return ok;
 }
 //=============================================================================
 //	eTape::ParseTAP
@@ -314,8 +365,9 @@ bool eTape::ParseTAP(const void* data, size_t data_size)
 		AllocInfocell();
 		Desc(ptr, size, tapeinfo[tape_infosize].desc);
 		tape_infosize++;
-		MakeBlock(ptr, size, 2168, 667, 735, 855, 1710, (*ptr < 4) ? 8064
-				: 3220, 1000);
+		dword pilot_len = (*ptr < 4) ? 8064 : 3220;
+		KeepBlock(ptr - (const byte*)data, size, pilot_len);
+		MakeBlock(ptr, size, 2168, 667, 735, 855, 1710, pilot_len, 1000);
 		ptr += size;
 	}
 	FindTapeSizes();
@@ -576,8 +628,10 @@ bool eTape::ParseTZX(const void* data, size_t data_size)
 			ptr += 4;
 			Desc(ptr, size, tapeinfo[tape_infosize].desc);
 			tape_infosize++;
-			MakeBlock(ptr, size, 2168, 667, 735, 855, 1710, (*ptr < 4) ? 8064
-					: 3220, pause);
+			n = (*ptr < 4) ? 8064 : 3220;
+			KeepBlock(ptr - (const byte*)data, size, n);
+			MakeBlock(ptr, size, 2168, 667, 735, 855, 1710, n, pause);
+
 			ptr += size;
 			break;
 		case 0x11: // turbo block
@@ -869,34 +923,144 @@ bool eTape::ParseTZX(const void* data, size_t data_size)
 	return (ptr == (const byte*)data + data_size);
 }
 //=============================================================================
-//	eTape::TapeBit
+//	eTape::CacheEdge
 //-----------------------------------------------------------------------------
-byte eTape::TapeBit(int tact)
+void eTape::CacheEdge()
 {
+	qword t = speccy->T();
+	if(tape.edge_change < t)
+		tape.edge_tact = -1;
+	else if(tape.edge_change - t >= 0x7FFFFFFF)
+		tape.edge_tact = 0x7FFFFFFF;
+	else
+		tape.edge_tact = (int)(tape.edge_change - t);
+}
+//=============================================================================
+//	eTape::TapeEdges
+//-----------------------------------------------------------------------------
+byte eTape::TapeEdges(int tact)
+{
+	const dword vol = 1000;
 	qword cur = speccy->T() + tact;
 	while(cur > tape.edge_change)
 	{
-		dword t = (dword)(tape.edge_change - speccy->T());
-		if((int)t >= 0)
-		{
-			const short vol = 1000;
-			short mono = tape.tape_bit ? vol : 0;
-			Update(tact, mono, mono);
-		}
+		int t = (int)(tape.edge_change - speccy->T());
 		dword pulse;
 		tape.tape_bit ^= -1;
+		edges.Add(this, t > 0 ? t : 0, tape.tape_bit ? vol : 0);
 		if(tape.play_pointer >= tape.end_of_tape ||
 				(pulse = tape_pulse[*tape.play_pointer++]) == (dword)-1)
-			StopTape();
+		{
+			tape.edge_change = 0x7FFFFFFFFFFFFFFFLL;
+			tape.tape_bit = -1;
+			tape.stop = true;
+		}
 		else
 			tape.edge_change += pulse;
 	}
+	CacheEdge();
 	return (byte)tape.tape_bit;
 }
 
+
 namespace xZ80
 {
 
+//*****************************************************************************
+//	eEdgeLoader
+//-----------------------------------------------------------------------------
+// known delay/edge detection loops of tape loaders, recognized at pc by
+// opcode signature. "??" in signature matches any byte.
+// to support new loader add its loop signature here.
+//-----------------------------------------------------------------------------
+struct eEdgeLoader
+{
+	enum eAction
+	{
+		A_DELAY_A,		// dec a loop: skip it
+		A_DELAY_A_JP,	// dec a:jp nz,$-1 (jp address should point to itself)
+		A_DELAY_B,		// djnz loop: skip it
+		A_EDGE_INC_B,	// edge search with b++ until 0xff
+		A_EDGE_DEC_B,	// edge search with b-- until 1
+	};
+	const char* signature;
+	eAction	action;
+	byte	tacts;		// t-states per loop iteration
+	byte	mask;		// tape bit mask (edge search only)
+};
+static const eEdgeLoader edge_loaders[] =
+{
+	{ "3D 20 FD A7",								eEdgeLoader::A_DELAY_A,		16 },	// dec a:jr nz,$-1
+	{ "10 FE",										eEdgeLoader::A_DELAY_B,		13 },	// djnz $
+	{ "3D C2 ?? ??",								eEdgeLoader::A_DELAY_A_JP,	14 },	// dec a:jp nz,$-1
+	{ "04 C8 3E ?? DB FE 1F D0 A9 E6 20 28 F3",		eEdgeLoader::A_EDGE_INC_B,	59, 0x20 },	// find edge (rom routine)
+	{ "04 C8 3E ?? DB FE CB 1F A9 E6 20 28 F3",		eEdgeLoader::A_EDGE_INC_B,	58, 0x20 },	// rra,ret nc => rr a (popeye2)
+	{ "04 C8 3E ?? DB FE 1F 00 A9 E6 20 28 F3",		eEdgeLoader::A_EDGE_INC_B,	58, 0x20 },	// ret nc nopped (some bleep loaders)
+	{ "04 C8 3E ?? DB FE A9 E6 40 D8 00 28 F3",		eEdgeLoader::A_EDGE_INC_B,	59, 0x40 },	// no rra, no break check (rana rama)
+	{ "04 C8 3E ?? DB FE 1F A9 E6 20 28 F4",		eEdgeLoader::A_EDGE_INC_B,	54, 0x20 },	// ret nc skipped: routine without BREAK checking (ZeroMusic & JSW)
+	{ "04 20 03 ?? ?? ?? DB ?? 1F C8 A9 E6 20 28 F1",	eEdgeLoader::A_EDGE_INC_B,	59, 0x20 },	// find edge from Donkey Kong
+	{ "3E ?? DB FE A9 E6 40 20 ?? 05 20 F4",		eEdgeLoader::A_EDGE_DEC_B,	52, 0x40 },	// lode runner
+};
+
+//*****************************************************************************
+//	eEdgeLoaders
+//-----------------------------------------------------------------------------
+// signatures compiled to masked byte patterns chained by first opcode,
+// so pc without known loader costs one table lookup
+//-----------------------------------------------------------------------------
+static class eEdgeLoaders
+{
+public:
+	enum { MAX_LEN = 16, COUNT = sizeof(edge_loaders)/sizeof(edge_loaders[0]) };
+	struct ePattern
+	{
+		int		len;
+		byte	data[MAX_LEN];
+		byte	mask[MAX_LEN];
+		const eEdgeLoader* loader;
+		ePattern* next;
+	};
+	eEdgeLoaders()
+	{
+		memset(by_opcode, 0, sizeof(by_opcode));
+		for(int i = 0; i < COUNT; ++i)
+		{
+			ePattern& p = patterns[i];
+			Compile(edge_loaders[i], &p);
+			ePattern** pp = &by_opcode[p.data[0]];
+			while(*pp)
+				pp = &(*pp)->next;
+			*pp = &p;
+		}
+	}
+	const ePattern* Find(byte opcode) const { return by_opcode[opcode]; }
+protected:
+	static int Hex(char c) { return (c >= '0' && c <= '9') ? c - '0' : c - 'A' + 10; }
+	void Compile(const eEdgeLoader& l, ePattern* p)
+	{
+		p->len = 0;
+		p->loader = &l;
+		p->next = NULL;
+		for(const char* s = l.signature; *s; )
+		{
+			if(*s == ' ')
+			{
+				++s;
+				continue;
+			}
+			assert(p->len < MAX_LEN);
+			bool any = s[0] == '?';
+			p->data[p->len] = any ? 0 : Hex(s[0])*0x10 + Hex(s[1]);
+			p->mask[p->len] = any ? 0 : 0xff;
+			++p->len;
+			s += 2;
+		}
+		assert(p->len && p->mask[0] == 0xff); // first opcode should be defined
+	}
+	ePattern* by_opcode[0x100];
+	ePattern patterns[COUNT];
+} edge_loader_table;
+
 //*****************************************************************************
 //	eZ80_FastTape
 //-----------------------------------------------------------------------------
@@ -910,165 +1074,80 @@ public:
 		StepTrap();
 		StepEdge();
 	}
+protected:
+	void Edge(const eEdgeLoader* l);
+	bool LoadBlock(eTape* tape);
 };
 //=============================================================================
 //	eZ80_FastTape::StepEdge
 //-----------------------------------------------------------------------------
 void eZ80_FastTape::StepEdge()
 {
-	byte p0 = memory->Read(pc + 0);
-	byte p1 = memory->Read(pc + 1);
-	byte p2 = memory->Read(pc + 2);
-	byte p3 = memory->Read(pc + 3);
-	if(p0 == 0x3D && p1 == 0x20 && p2 == 0xFD && p3 == 0xA7)
-	{ // dec a:jr nz,$-1
-		t += ((byte)(a - 1)) * 16;
-		a = 1;
+	byte code[eEdgeLoaders::MAX_LEN];
+	code[0] = memory->Read(pc);
+	const eEdgeLoaders::ePattern* p = edge_loader_table.Find(code[0]);
+	if(!p)
 		return;
-	}
-	if(p0 == 0x10 && p1 == 0xFE)
-	{ // djnz $
-		t += ((byte)(b - 1)) * 13;
-		b = 1;
-		return;
-	}
-	if(p0 == 0x3D && p1 == 0xC2 && pc == dword(p3) * 0x100 + p2)
-	{ // dec a:jp nz,$-1
-		t += ((byte)(a - 1)) * 14;
-		a = 1;
-		return;
-	}
-	if(p0 == 0x04 && p1 == 0xC8 && p2 == 0x3E)
+	int code_len = 1;
+	for(; p; p = p->next)
 	{
-		byte p04 = memory->Read(pc + 4);
-		byte p05 = memory->Read(pc + 5);
-		byte p06 = memory->Read(pc + 6);
-		byte p07 = memory->Read(pc + 7);
-		byte p08 = memory->Read(pc + 8);
-		byte p09 = memory->Read(pc + 9);
-		byte p10 = memory->Read(pc + 10);
-		byte p11 = memory->Read(pc + 11);
-		byte p12 = memory->Read(pc + 12);
-		if(p04 == 0xDB && p05 == 0xFE && p06 == 0x1F && p07 == 0xD0 && p08
-				== 0xA9 && p09 == 0xE6 && p10 == 0x20 && p11 == 0x28 && p12
-				== 0xF3)
-		{ // find edge (rom routine)
-			eTape* tape = devices->Get<eTape>();
-			for(;;)
-			{
-				if(b == 0xFF)
-					return;
-				if((tape->TapeBit(T()) ^ c) & 0x20)
-	            	return;
-				b++;
-				t += 59;
-			}
-		}
-		if(p04 == 0xDB && p05 == 0xFE && p06 == 0xCB && p07 == 0x1F && p08
-				== 0xA9 && p09 == 0xE6 && p10 == 0x20 && p11 == 0x28 && p12
-				== 0xF3)
-		{ // rra,ret nc => rr a (popeye2)
-			eTape* tape = devices->Get<eTape>();
-			for(;;)
-			{
-				if(b == 0xFF)
-					return;
-				if((tape->TapeBit(T()) ^ c) & 0x20)
-					return;
-				b++;
-				t += 58;
-			}
-		}
-		if(p04 == 0xDB && p05 == 0xFE && p06 == 0x1F && p07 == 0x00 && p08
-				== 0xA9 && p09 == 0xE6 && p10 == 0x20 && p11 == 0x28 && p12
-				== 0xF3)
-		{ // ret nc nopped (some bleep loaders)
-			eTape* tape = devices->Get<eTape>();
-			for(;;)
-			{
-				if(b == 0xFF)
-					return;
-				if((tape->TapeBit(T()) ^ c) & 0x20)
-					return;
-				b++;
-				t += 58;
-			}
-		}
-		if(p04 == 0xDB && p05 == 0xFE && p06 == 0xA9 && p07 == 0xE6 && p08
-				== 0x40 && p09 == 0xD8 && p10 == 0x00 && p11 == 0x28 && p12
-				== 0xF3)
-		{ // no rra, no break check (rana rama)
-			eTape* tape = devices->Get<eTape>();
-			for(;;)
-			{
-				if(b == 0xFF)
-					return;
-				if((tape->TapeBit(T()) ^ c) & 0x40)
-					return;
-				b++;
-				t += 59;
-			}
+		int i = 1;
+		for(; i < p->len; ++i)
+		{
+			for(; code_len <= i; ++code_len)
+				code[code_len] = memory->Read(pc + code_len);
+			if((code[i] & p->mask[i]) != p->data[i])
+				break;
 		}
-		if(p04 == 0xDB && p05 == 0xFE && p06 == 0x1F && p07 == 0xA9 && p08
-				== 0xE6 && p09 == 0x20 && p10 == 0x28 && p11 == 0xF4)
-		{ // ret nc skipped: routine without BREAK checking (ZeroMusic & JSW)
-			eTape* tape = devices->Get<eTape>();
-			for(;;)
-			{
-				if(b == 0xFF)
-					return;
-				if((tape->TapeBit(T()) ^ c) & 0x20)
-					return;
-				b++;
-				t += 54;
-			}
+		if(i == p->len)
+		{
+			const eEdgeLoader* l = p->loader;
+			if(l->action == eEdgeLoader::A_DELAY_A_JP && pc != dword(code[3])*0x100 + code[2])
+				continue;
+			Edge(l);
+			return;
 		}
 	}
-	if(p0 == 0x04 && p1 == 0x20 && p2 == 0x03)
+}
+//=============================================================================
+//	eZ80_FastTape::Edge
+//-----------------------------------------------------------------------------
+void eZ80_FastTape::Edge(const eEdgeLoader* l)
+{
+	switch(l->action)
 	{
-		byte p06 = memory->Read(pc + 6);
-		byte p08 = memory->Read(pc + 8);
-		byte p09 = memory->Read(pc + 9);
-		byte p10 = memory->Read(pc + 10);
-		byte p11 = memory->Read(pc + 11);
-		byte p12 = memory->Read(pc + 12);
-		byte p13 = memory->Read(pc + 13);
-		byte p14 = memory->Read(pc + 14);
-		if(p06 == 0xDB && p08 == 0x1F && p09 == 0xC8 && p10 == 0xA9 && p11
-				== 0xE6 && p12 == 0x20 && p13 == 0x28 && p14 == 0xF1)
-		{ // find edge from Donkey Kong
+	case eEdgeLoader::A_DELAY_A:
+	case eEdgeLoader::A_DELAY_A_JP:
+		t += ((byte)(a - 1)) * l->tacts;
+		a = 1;
+		break;
+	case eEdgeLoader::A_DELAY_B:
+		t += ((byte)(b - 1)) * l->tacts;
+		b = 1;
+		break;
+	case eEdgeLoader::A_EDGE_INC_B:
+		{
 			eTape* tape = devices->Get<eTape>();
 			for(;;)
 			{
 				if(b == 0xFF)
 					return;
-				if((tape->TapeBit(T()) ^ c) & 0x20)
+				if((tape->TapeBit(T()) ^ c) & l->mask)
 					return;
 				b++;
-				t += 59;
+				t += l->tacts;
 			}
 		}
-	}
-	if(p0 == 0x3E && p2 == 0xDB && p3 == 0xFE)
-	{
-		byte p04 = memory->Read(pc + 4);
-		byte p05 = memory->Read(pc + 5);
-		byte p06 = memory->Read(pc + 6);
-		byte p07 = memory->Read(pc + 7);
-		byte p09 = memory->Read(pc + 9);
-		byte p10 = memory->Read(pc + 10);
-		byte p11 = memory->Read(pc + 11);
-		if(p04 == 0xA9 && p05 == 0xE6 && p06 == 0x40 && p07 == 0x20 && p09
-				== 0x05 && p10 == 0x20 && p11 == 0xF4)
-		{ // lode runner
+	case eEdgeLoader::A_EDGE_DEC_B:
+		{
 			eTape* tape = devices->Get<eTape>();
 			for(;;)
 			{
 				if(b == 1)
 					return;
-				if((tape->TapeBit(T()) ^ c) & 0x40)
+				if((tape->TapeBit(T()) ^ c) & l->mask)
 					return;
-				t += 52;
+				t += l->tacts;
 				b--;
 			}
 		}
@@ -1082,6 +1161,8 @@ void eZ80_FastTape::StepTrap()
 	if((pc & 0xFFFF) != 0x056B)
 		return;
 	eTape* tape = devices->Get<eTape>();
+	if(tape->instant && LoadBlock(tape))
+		return;
 	dword pulse;
 	do
 	{
@@ -1150,6 +1231,79 @@ void eZ80_FastTape::StepTrap()
 	bc = 0xB001;
 	h = 0;
 }
+//=============================================================================
+//	eZ80_FastTape::LoadBlock
+//-----------------------------------------------------------------------------
+// load whole standard speed block from original tape data at ix/de
+// (flag in a', load/verify in carry of f') and leave ROM loader with result
+// return false if current block has no original data (pulses should be decoded)
+//-----------------------------------------------------------------------------
+bool eZ80_FastTape::LoadBlock(eTape* tape)
+{
+	if(!tape->tape.play_pointer)
+		return false;
+	tape->FindTapeIndex();
+	dword idx = tape->tape.index;
+	const eTape::TAPEINFO& ti = tape->tapeinfo[idx];
+	if(!ti.block_size || tape->tape.play_pointer > tape->tape_image + ti.block_pulses)
+		return false; // not standard block or it's data is playing already
+	const byte* data = tape->tape_file->Data() + ti.block_pos;
+
+	dword size = ti.block_size;
+
+	// skip to next block as ROM loader does
+	tape->tape.play_pointer = (idx + 1 < tape->tape_infosize) ?
+			tape->tape_image + tape->tapeinfo[idx + 1].pos : tape->tape.end_of_tape;
+	tape->tape.edge_change = tape->speccy->T() + T();
+	tape->tape.tape_bit = -1;
+	tape->CacheEdge();
+
+
+	if(data[0] != alt.a)
+	{ // wrong flag
+		f &= ~CF;
+		pc = 0x05E2;
+	}
+	else
+	{
+		bool verify = !(alt.f & CF);
+		dword len = (de & 0xFFFF) ? (de & 0xFFFF) : 0x10000;
+		byte parity = data[0];
+		dword i = 1;
+		for(; i < size && len; ++i)
+		{
+			if(verify)
+			{
+				if(memory->Read(ix) != data[i])
+					break;
+			}
+			else
+				memory->Write(ix, data[i]);
+			parity ^= data[i];
+			ix++;
+			--de;
+			--len;
+		}
+		if(len || i >= size)
+		{ // verify error or tape block is too short
+			f &= ~CF;
+			pc = 0x05E2;
+		}
+		else
+		{
+			parity ^= data[i]; // checksum
+			pc = 0x05DF;
+			f |= CF;
+			bc = 0xB001;
+			h = parity;
+		}
+	}
+	if(tape->tape.play_pointer >= tape->tape.end_of_tape)
+		tape->Stop();
+	return true;
+
+}
+
 
 }
 //namespace xZ80
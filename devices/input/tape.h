@@ -26,6 +26,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 class eSpeccy;
 namespace xZ80 { class eZ80_FastTape; }
+namespace xIo { class eFileData; }
 
 class eTape : public eDeviceSound
 {
@@ -36,20 +37,30 @@ public:
 	virtual ~eTape() { CloseTape(); }
 	virtual void Init();
 	virtual void Reset();
-	virtual bool IoRead(word port) const;
+	virtual void FrameStart(dword tacts);
+	virtual void FrameEnd(dword tacts);
+	virtual int IoReadDecode(eIoDecode* d) const;
 	virtual void IoRead(word port, byte* v, int tact);
 
-	bool Open(const char* type, const void* data, size_t data_size);
+	bool Open(const char* type, xIo::eFileData* file); // keeps reference to file
 	void Start();
 	void Stop();
 	bool Started() const;
 	bool Inserted() const;
+	void Instant(bool on) { instant = on; }
 
 	static eDeviceId Id() { return D_TAPE; }
 	virtual dword IoNeed() const { return ION_READ; }
 
-	byte TapeBit(int tact);
+	byte TapeBit(int tact)
+	{
+		if(tact <= tape.edge_tact) // no edges till next one
+			return (byte)tape.tape_bit;
+		return TapeEdges(tact);
+	}
 protected:
+	byte TapeEdges(int tact);
+	void CacheEdge();
 	bool ParseTAP(const void* data, size_t data_size);
 	bool ParseCSW(const void* data, size_t data_size);
 	bool ParseTZX(const void* data, size_t data_size);
@@ -62,6 +73,7 @@ protected:
 	void StartTape();
 	void CloseTape();
 	void Reserve(dword datasize);
+	void KeepBlock(dword pos, dword size, dword pilot_len);
 	void MakeBlock(const byte* data, dword size, dword pilot_t,
 	      dword s1_t, dword s2_t, dword zero_t, dword one_t,
 	      dword pilot_len, dword pause, byte last = 8);
@@ -81,14 +93,21 @@ protected:
 		byte* end_of_tape;  // where to stop tape
 		dword index;    // current tape block
 		dword tape_bit;
+		int edge_tact;  // edge_change relative to frame start (cached)
+		bool stop;      // end of tape reached, stop it at frame end
 	};
 	eTapeState tape;
 
+	eSoundEdges edges; // tape sound changes during frame
+
 	struct TAPEINFO
 	{
 	   char desc[280];
 	   dword pos;
 	   dword t_size;
+	   dword block_pos;    // original block bytes offset in tape_file
+	   dword block_size;   // or 0 if block isn't standard speed one
+	   dword block_pulses; // block data pulses offset in tape_image
 	};
 
 	dword tape_pulse[0x100];
@@ -98,7 +117,12 @@ protected:
 	byte* tape_image;
 	dword tape_imagesize;
 
+	xIo::eFileData* tape_file; // original image, standard speed blocks used by instant load
+
+	bool instant;
+
 	TAPEINFO* tapeinfo;
+
 	dword tape_infosize;
 
 	dword appendable;
@@ -113,11 +113,12 @@ void eRom::Reset()
 	SelectPage(mode_48k ? ROM_48 : ROM_SYS);
 }
 //=============================================================================
-//	eRom::IoWrite
+//	eRom::IoWriteDecode
 //-----------------------------------------------------------------------------
-bool eRom::IoWrite(word port) const
+int eRom::IoWriteDecode(eIoDecode* d) const
 {
-	return !mode_48k && !(port & 2) && !(port & 0x8000); // zx128 port
+	static const eIoDecode ports[] = { { 0x8002, 0x0000, false } };	// #7ffd
+	return IoDecode(d, ports, mode_48k ? 0 : 1); // zx128 port
 }
 //=============================================================================
 //	eRom::IoWrite
@@ -137,11 +138,12 @@ void eRam::Reset()
 	memory->SetPage(3, eMemory::P_RAM0);
 }
 //=============================================================================
-//	eRam::IoWrite
+//	eRam::IoWriteDecode
 //-----------------------------------------------------------------------------
-bool eRam::IoWrite(word port) const
+int eRam::IoWriteDecode(eIoDecode* d) const
 {
-	return !mode_48k && !(port & 2) && !(port & 0x8000); // zx128 port
+	static const eIoDecode ports[] = { { 0x8002, 0x0000, false } };	// #7ffd
+	return IoDecode(d, ports, mode_48k ? 0 : 1); // zx128 port
 }
 //=============================================================================
 //	eRam::IoWrite
@@ -47,6 +47,7 @@ public:
 		*a = v;
 	}
 	byte* Get(int page) { return memory + page * PAGE_SIZE; }
+	byte* Bank(int idx) const { return bank_write[idx]; } // NULL if rom
 
 	enum ePage
 	{
@@ -74,21 +75,23 @@ public:
 	eRom(eMemory* m) : memory(m), page_selected(0), mode_48k(false) {}
 	virtual void Init();
 	virtual void Reset();
-	virtual bool IoWrite(word port) const;
+	virtual int IoWriteDecode(eIoDecode* d) const;
 	virtual void IoWrite(word port, byte v, int tact);
-	void Read(word addr)
+	void Read(word addr) { Read(addr, ROM_SOS()); }
+	void Read(word addr, int rom_sos)
 	{
 		byte pc_h = addr >> 8;
-		if(page_selected == ROM_SOS() && (pc_h == 0x3d))
+		if(page_selected == rom_sos && (pc_h == 0x3d))
 		{
 			SelectPage(ROM_DOS);
 		}
 		else if(DosSelected() && (pc_h & 0xc0)) // pc > 0x3fff closes tr-dos
 		{
-			SelectPage(ROM_SOS());
+			SelectPage(rom_sos);
 		}
 	}
 	void SelectPage(int page) { page_selected = page; memory->SetPage(0, page_selected); }
+	int Page() const { return page_selected; }
 	bool DosSelected() const { return page_selected == ROM_DOS; }
 	void Mode48k(bool on) { mode_48k = on; }
 	int ROM_SOS() const { return mode_48k ? ROM_48 : ROM_128_0; }
@@ -120,7 +123,7 @@ class eRam : public eDevice
 public:
 	eRam(eMemory* m) : memory(m), mode_48k(false) {}
 	virtual void Reset();
-	virtual bool IoWrite(word port) const;
+	virtual int IoWriteDecode(eIoDecode* d) const;
 	virtual void IoWrite(word port, byte v, int tact);
 	void Mode48k(bool on) { mode_48k = on; }
 	bool Mode48k() const { return mode_48k; }
@@ -23,7 +23,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //=============================================================================
 //	eAY::eAY
 //-----------------------------------------------------------------------------
-eAY::eAY() : t(0), ta(0), tb(0), tc(0), tn(0), te(0), env(0), denv(0)
+eAY::eAY() : log(logs[0]), log_count(0), synth_log(logs[1]), synth_log_count(0), thread(NULL), frame_skip(false)
+	,t(0), ta(0), tb(0), tc(0), tn(0), te(0), env(0), denv(0)
 	,bitA(0), bitB(0), bitC(0), bitN(0), ns(0)
 	,bit0(0), bit1(0), bit2(0), bit3(0), bit4(0), bit5(0)
 	,ea(0), eb(0), ec(0), va(0), vb(0), vc(0)
@@ -36,24 +37,31 @@ eAY::eAY() : t(0), ta(0), tb(0), tc(0), tn(0), te(0), env(0), denv(0)
 	_Reset();
 }
 //=============================================================================
-//	eAY::IoRead
+//	eAY::~eAY
 //-----------------------------------------------------------------------------
-bool eAY::IoRead(word port) const
+eAY::~eAY()
 {
-	return (port&0xC0FF) == 0xC0FD;
+	SAFE_DELETE(thread);
 }
 //=============================================================================
-//	eAY::IoWrite
+//	eAY::IoReadDecode
+//-----------------------------------------------------------------------------
+int eAY::IoReadDecode(eIoDecode* d) const
+{
+	static const eIoDecode ports[] = { { 0xc0ff, 0xc0fd, false } };	// #fffd
+	return IoDecode(d, ports, 1);
+}
+//=============================================================================
+//	eAY::IoWriteDecode
 //-----------------------------------------------------------------------------
-bool eAY::IoWrite(word port) const
+int eAY::IoWriteDecode(eIoDecode* d) const
 {
- 	if(port&2)
-		return false;
- 	if((port & 0xC0FF) == 0xC0FD)
-		return true;
- 	if((port & 0xC000) == 0x8000)
- 		return true;
-	return false;
+	static const eIoDecode ports[] =
+	{
+		{ 0xc0ff, 0xc0fd, false },	// #fffd
+		{ 0xc002, 0x8000, false },	// #bffd
+	};
+	return IoDecode(d, ports, 2);
 }
 //=============================================================================
 //	eAY::IoRead
@@ -86,13 +94,122 @@ const dword MULT_C_1 = 14; // fixed point precision for 'system tick -> ay tick'
 //-----------------------------------------------------------------------------
 void eAY::FrameStart(dword tacts)
 {
-	t = tacts * chip_clock_rate / system_clock_rate;
-	eInherited::FrameStart(t);
+	if(thread)
+		Log(tacts, eWrite::W_START, frame_skip);
+	else
+		SynthFrameStart(tacts);
 }
 //=============================================================================
 //	eAY::FrameEnd
 //-----------------------------------------------------------------------------
 void eAY::FrameEnd(dword tacts)
+{
+	if(!thread)
+	{
+		SynthFrameEnd(tacts);
+		return;
+	}
+	Log(tacts, eWrite::W_END, 0);
+	thread->Wait();
+	AudioDataPublish();
+	eWrite* l = synth_log;
+	synth_log = log;
+	synth_log_count = log_count;
+	log = l;
+	log_count = 0;
+	thread->Start(this);
+}
+//=============================================================================
+//	eAY::Skip
+//-----------------------------------------------------------------------------
+void eAY::Skip(bool on)
+{
+	frame_skip = on;
+	if(!thread)
+		skip = on;
+}
+//=============================================================================
+//	eAY::Threaded
+//-----------------------------------------------------------------------------
+void eAY::Threaded(bool on)
+{
+	if(on == (thread != NULL))
+		return;
+	if(thread)
+	{
+		thread->Wait();
+		Synthesize(log, log_count);
+		log_count = 0;
+		AudioDataPublish();
+		SAFE_DELETE(thread);
+		deferred = false;
+		skip = frame_skip;
+	}
+	else
+	{
+		readypos = dstpos;
+		used = false;
+		deferred = true;
+		thread = new eJobThread;
+	}
+}
+//=============================================================================
+//	eAY::Log
+//-----------------------------------------------------------------------------
+void eAY::Log(dword tact, byte nreg, byte v)
+{
+	if(log_count == LOG_MAX) // too many writes in frame, synthesize them here
+	{
+		thread->Wait();
+		Synthesize(log, log_count);
+		log_count = 0;
+	}
+	eWrite& w = log[log_count++];
+	w.t = tact;
+	w.reg = nreg;
+	w.v = v;
+}
+//=============================================================================
+//	eAY::Execute
+//-----------------------------------------------------------------------------
+void eAY::Execute()
+{
+	Synthesize(synth_log, synth_log_count);
+}
+//=============================================================================
+//	eAY::Synthesize
+//-----------------------------------------------------------------------------
+void eAY::Synthesize(const eWrite* w, int count)
+{
+	for(; --count >= 0; ++w)
+	{
+		switch(w->reg)
+		{
+		case eWrite::W_START:
+			skip = w->v != 0;
+			SynthFrameStart(w->t);
+			break;
+		case eWrite::W_END:
+			SynthFrameEnd(w->t);
+			break;
+		default:
+			Apply(w->t, w->reg, w->v);
+			break;
+		}
+	}
+}
+//=============================================================================
+//	eAY::SynthFrameStart
+//-----------------------------------------------------------------------------
+void eAY::SynthFrameStart(dword tacts)
+{
+	t = tacts * chip_clock_rate / system_clock_rate;
+	eInherited::FrameStart(t);
+}
+//=============================================================================
+//	eAY::SynthFrameEnd
+//-----------------------------------------------------------------------------
+void eAY::SynthFrameEnd(dword tacts)
 {
 	//adjusting 't' with whole history will fix accumulation of rounding errors
 	qword end_chip_tick = ((passed_clk_ticks + tacts) * chip_clock_rate) / system_clock_rate;
@@ -106,6 +223,12 @@ void eAY::FrameEnd(dword tacts)
 //-----------------------------------------------------------------------------
 void eAY::Flush(dword chiptick)
 {
+	if(skip)
+	{
+		if(t < chiptick)
+			t = chiptick;
+		return;
+	}
 	// todo: noaction at (temp.sndblock || !conf.sound.ay)
 	while (t < chiptick)
 	{
@@ -167,15 +290,26 @@ void eAY::Write(dword timestamp, byte val)
 	if((1 << activereg) & ((1<<1)|(1<<3)|(1<<5)|(1<<13))) val &= 0x0F;
 	if((1 << activereg) & ((1<<6)|(1<<8)|(1<<9)|(1<<10))) val &= 0x1F;
 
-	if(activereg != 13 && reg[activereg] == val)
+	if(activereg != 13 && cpu_reg[activereg] == val)
 		return;
 
-	reg[activereg] = val;
+	cpu_reg[activereg] = val;
+	if(thread)
+		Log(timestamp, activereg, val);
+	else
+		Apply(timestamp, activereg, val);
+}
+//=============================================================================
+//	eAY::Apply
+//-----------------------------------------------------------------------------
+void eAY::Apply(dword timestamp, byte nreg, byte val)
+{
+	reg[nreg] = val;
 
 	if(timestamp)
 		Flush((timestamp * mult_const) >> MULT_C_1); // cputick * ( (chip_clock_rate/8) / system_clock_rate );
 
-	switch(activereg)
+	switch(nreg)
 	{
 	case 0:
 	case 1:
@@ -230,13 +364,15 @@ byte eAY::Read()
 {
 	if(activereg >= 0x10)
 		return 0xFF;
-	return reg[activereg & 0x0F];
+	return cpu_reg[activereg & 0x0F];
 }
 //=============================================================================
 //	eAY::SetTimings
 //-----------------------------------------------------------------------------
 void eAY::SetTimings(dword _system_clock_rate, dword _chip_clock_rate, dword _sample_rate)
 {
+	if(thread)
+		thread->Wait();
 	_chip_clock_rate /= 8;
 
 	system_clock_rate = _system_clock_rate;
@@ -252,6 +388,8 @@ void eAY::SetTimings(dword _system_clock_rate, dword _chip_clock_rate, dword _sa
 //-----------------------------------------------------------------------------
 void eAY::SetVolumes(dword global_vol, const SNDCHIP_VOLTAB *voltab, const SNDCHIP_PANTAB *stereo)
 {
+	if(thread)
+		thread->Wait();
 	for (int j = 0; j < 6; j++)
 		for (int i = 0; i < 32; i++)
 			vols[j][i] = (dword)(((qword)global_vol * voltab->v[i] * stereo->raw[j])/(65535*100*3));
@@ -262,7 +400,7 @@ void eAY::SetVolumes(dword global_vol, const SNDCHIP_VOLTAB *voltab, const SNDCH
 void eAY::_Reset(dword timestamp)
 {
 	for(int i = 0; i < 16; i++)
-		reg[i] = 0;
+		cpu_reg[i] = 0;
 	ApplyRegs(timestamp);
 }
 //=============================================================================
@@ -274,7 +412,7 @@ void eAY::ApplyRegs(dword timestamp)
 	for(byte r = 0; r < 16; r++)
 	{
 		Select(r);
-		byte p = reg[r];
+		byte p = cpu_reg[r];
 		/* clr cached values */
 		Write(timestamp, p ^ 1);
 		Write(timestamp, p);
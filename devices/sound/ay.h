@@ -20,6 +20,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define __AY_H__
 
 #include "device_sound.h"
+#include "../../tools/job_thread.h"
 
 #pragma once
 
@@ -69,15 +70,15 @@ extern const SNDCHIP_PANTAB* SNDR_PAN_CBA;
 //=============================================================================
 //	eAY
 //-----------------------------------------------------------------------------
-class eAY : public eDeviceSound
+class eAY : public eDeviceSound, public eJobThread::eJob
 {
 	typedef eDeviceSound eInherited;
 public:
 	eAY();
-	virtual ~eAY() {}
+	virtual ~eAY();
 
-	virtual bool IoRead(word port) const;
-	virtual bool IoWrite(word port) const;
+	virtual int IoReadDecode(eIoDecode* d) const;
+	virtual int IoWriteDecode(eIoDecode* d) const;
 	virtual void IoRead(word port, byte* v, int tact);
 	virtual void IoWrite(word port, byte v, int tact);
 
@@ -87,12 +88,16 @@ public:
 	void SetChip(CHIP_TYPE type) { chiptype = type; }
 	void SetTimings(dword system_clock_rate, dword chip_clock_rate, dword sample_rate);
 	void SetVolumes(dword global_vol, const SNDCHIP_VOLTAB *voltab, const SNDCHIP_PANTAB *stereo);
-	void SetRegs(const byte _reg[16]) { memcpy(reg, _reg, sizeof(reg)); ApplyRegs(0); }
+	void SetRegs(const byte _reg[16]) { memcpy(cpu_reg, _reg, sizeof(cpu_reg)); ApplyRegs(0); }
 	void Select(byte nreg);
+	const byte* Regs() const { return cpu_reg; }
+	byte Selected() const { return activereg; }
+	void Threaded(bool on); // synthesize frame in background while cpu runs the next one
 
 	virtual void Reset() { _Reset(); }
 	virtual void FrameStart(dword tacts);
 	virtual void FrameEnd(dword tacts);
+	virtual void Skip(bool on);
 
 	static eDeviceId Id() { return D_AY; }
 	virtual dword IoNeed() const { return ION_WRITE|ION_READ; }
@@ -101,6 +106,28 @@ protected:
 	void Write(dword timestamp, byte val);
 	byte Read();
 
+	// register writes logged during frame when threaded, synthesized all at once
+	struct eWrite
+	{
+		enum { W_START = 0x10, W_END }; // reg for frame start/end (v is skip flag for start)
+		dword	t;
+		byte	reg;
+		byte	v;
+	};
+	enum { LOG_MAX = 4096 };
+	void Log(dword tact, byte nreg, byte v);
+	void Synthesize(const eWrite* w, int count);
+	virtual void Execute();
+
+	eWrite	logs[2][LOG_MAX];
+	eWrite*	log;
+	int		log_count;
+	eWrite*	synth_log;
+	int		synth_log_count;
+	eJobThread* thread;
+	bool	frame_skip;
+	byte	cpu_reg[16];	// as seen by cpu, synthesizer has its own copy
+
 private:
 	dword t, ta, tb, tc, tn, te, env;
 	int denv;
@@ -126,6 +153,9 @@ private:
 	void _Reset(dword timestamp = 0); // call with default parameter, when context outside start_frame/end_frame block
 	void Flush(dword chiptick);
 	void ApplyRegs(dword timestamp = 0);
+	void Apply(dword timestamp, byte nreg, byte val);
+	void SynthFrameStart(dword tacts);
+	void SynthFrameEnd(dword tacts);
 };
 
 #endif//__AY_H__
@@ -20,11 +20,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "beeper.h"
 
 //=============================================================================
-//	eBeeper::IoWrite
+//	eBeeper::IoWriteDecode
 //-----------------------------------------------------------------------------
-bool eBeeper::IoWrite(word port) const
+int eBeeper::IoWriteDecode(eIoDecode* d) const
 {
-	return !(port&1);
+	static const eIoDecode ports[] = { { 0x0001, 0x0000, false } };	// #fe
+	return IoDecode(d, ports, 1);
 }
 //=============================================================================
 //	eBeeper::IoWrite
@@ -36,5 +37,16 @@ void eBeeper::IoWrite(word port, byte v, int tact)
 	short spk = (v & 0x10) ? spk_vol : 0;
 	short mic = (v & 0x08) ? mic_vol : 0;
 	short mono = spk + mic;
-	Update(tact, mono, mono);
+	if(mono == level)
+		return;
+	level = mono;
+	edges.Add(this, tact, mono);
+}
+//=============================================================================
+//	eBeeper::FrameEnd
+//-----------------------------------------------------------------------------
+void eBeeper::FrameEnd(dword tacts)
+{
+	edges.Flush(this);
+	eInherited::FrameEnd(tacts);
 }
@@ -28,11 +28,18 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //-----------------------------------------------------------------------------
 class eBeeper : public eDeviceSound
 {
+	typedef eDeviceSound eInherited;
 public:
-	virtual bool IoWrite(word port) const;
+	eBeeper() : level(0) {}
+	virtual int IoWriteDecode(eIoDecode* d) const;
 	virtual void IoWrite(word port, byte v, int tact);
+	virtual void FrameEnd(dword tacts);
 	static eDeviceId Id() { return D_BEEPER; }
 	virtual dword IoNeed() const { return ION_WRITE; }
+
+protected:
+	short	level;
+	eSoundEdges edges;
 };
 
 #endif//__BEEPER_H__
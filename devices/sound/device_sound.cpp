@@ -22,7 +22,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //=============================================================================
 //	eDeviceSound::eDeviceSound
 //-----------------------------------------------------------------------------
-eDeviceSound::eDeviceSound() : mix_l(0), mix_r(0), s1_l(0), s1_r(0), s2_l(0), s2_r(0)
+eDeviceSound::eDeviceSound() : mix_l(0), mix_r(0), skip(false), deferred(false), used(false), s1_l(0), s1_r(0), s2_l(0), s2_r(0)
 {
 	SetTimings(SNDR_DEFAULT_SYSTICK_RATE, SNDR_DEFAULT_SAMPLE_RATE);
 }
@@ -38,18 +38,27 @@ const dword TICK_F = (1<<TICK_FF);
 //-----------------------------------------------------------------------------
 void eDeviceSound::FrameStart(dword tacts)
 {
-	dword endtick = (tacts * (qword)sample_rate * TICK_F) / clock_rate; //prev frame rest
+	dword endtick = Ticks(tacts); //prev frame rest
 	base_tick = tick - endtick;
 }
 //=============================================================================
+//	eDeviceSound::Ticks
+//-----------------------------------------------------------------------------
+// sound ticks passed in tacts, rounded down
+dword eDeviceSound::Ticks(dword tacts) const
+{
+	if(tacts <= tacts_max)
+		return tacts * tick_mul / tick_div;
+	return (tacts * (qword)sample_rate * TICK_F) / clock_rate;
+}
+//=============================================================================
 //	eDeviceSound::Update
 //-----------------------------------------------------------------------------
 void eDeviceSound::Update(dword tact, dword l, dword r)
 {
 	if(!((l ^ mix_l) | (r ^ mix_r)))
 		return;
-	dword endtick = (tact * (qword)sample_rate * TICK_F) / clock_rate;
-	Flush(base_tick + endtick);
+	Flush(base_tick + Ticks(tact));
 	mix_l = l; mix_r = r;
 }
 //=============================================================================
@@ -57,8 +66,7 @@ void eDeviceSound::Update(dword tact, dword l, dword r)
 //-----------------------------------------------------------------------------
 void eDeviceSound::FrameEnd(dword tacts)
 {
-	dword endtick = (tacts * (qword)sample_rate * TICK_F) / clock_rate;
-	Flush(base_tick + endtick);
+	Flush(base_tick + Ticks(tacts));
 }
 //=============================================================================
 //	eDeviceSound::AudioData
@@ -72,6 +80,8 @@ void* eDeviceSound::AudioData()
 //-----------------------------------------------------------------------------
 dword eDeviceSound::AudioDataReady()
 {
+	if(deferred)
+		return used ? 0 : (readypos - buffer)*sizeof(SNDSAMPLE);
 	return (dstpos - buffer)*sizeof(SNDSAMPLE);
 }
 //=============================================================================
@@ -80,7 +90,27 @@ dword eDeviceSound::AudioDataReady()
 void eDeviceSound::AudioDataUse(dword size)
 {
 	assert(size == AudioDataReady());
-	dstpos = buffer;
+	if(deferred)
+		used = true;
+	else
+		dstpos = buffer;
+}
+//=============================================================================
+//	eDeviceSound::AudioDataPublish
+//-----------------------------------------------------------------------------
+// samples are complete up to dstpos (synthesis thread is idle), give them out
+void eDeviceSound::AudioDataPublish()
+{
+	if(used)
+	{
+		int rest = dstpos - readypos;
+		memmove(buffer, readypos, rest*sizeof(SNDSAMPLE));
+		dstpos = buffer + rest;
+		used = false;
+	}
+	else if(dstpos - buffer > BUFFER_LEN/2) // nobody takes them, don't let the ring wrap
+		dstpos = buffer;
+	readypos = dstpos;
 }
 //=============================================================================
 //	eDeviceSound::SetTimings
@@ -90,8 +120,21 @@ void eDeviceSound::SetTimings(dword _clock_rate, dword _sample_rate)
 	clock_rate = _clock_rate;
 	sample_rate = _sample_rate;
 
+	// same ratio reduced, so tacts of frame usually convert without 64-bit division
+	dword a = sample_rate * TICK_F, b = clock_rate;
+	while(b)
+	{
+		dword r = a % b;
+		a = b;
+		b = r;
+	}
+	tick_mul = sample_rate * TICK_F / a;
+	tick_div = clock_rate / a;
+	tacts_max = 0xffffffff / tick_mul;
+
 	tick = base_tick = 0;
-	dstpos = buffer;
+	dstpos = readypos = buffer;
+	used = false;
 }
 
 static dword filter_diff[TICK_F*2];
@@ -99,11 +142,43 @@ const double filter_sum_full = 1.0, filter_sum_half = 0.5;
 const dword filter_sum_full_u = (dword)(filter_sum_full * 0x10000);
 const dword filter_sum_half_u = (dword)(filter_sum_half * 0x10000);
 
+//=============================================================================
+//	eDeviceSound::Fill
+//-----------------------------------------------------------------------------
+// put the same sample count times (at most two block fills if it fits ring)
+void eDeviceSound::Fill(dword sample_value, dword count)
+{
+	while(count)
+	{
+		dword c = buffer + BUFFER_LEN - dstpos;
+		if(c > count)
+			c = count;
+		dword* p = &dstpos->sample;
+		if(!sample_value)
+			memset(p, 0, c*sizeof(SNDSAMPLE));
+		else
+		{
+			for(dword i = c; i; --i)
+				*p++ = sample_value;
+		}
+		dstpos += c;
+		count -= c;
+		if(dstpos - buffer >= BUFFER_LEN)
+		{
+			dstpos = buffer;
+		}
+	}
+}
 //=============================================================================
 //	eDeviceSound::Flush
 //-----------------------------------------------------------------------------
 void eDeviceSound::Flush(dword endtick)
 {
+	if(skip)
+	{
+		tick = endtick;
+		return;
+	}
 	dword scale;
 	if(!((endtick ^ tick) & ~(TICK_F-1)))
 	{
@@ -144,24 +219,25 @@ void eDeviceSound::Flush(dword endtick)
 			// assume filter_coeff is symmetric
 			dword val_l = mix_l * filter_sum_half_u;
 			dword val_r = mix_r * filter_sum_half_u;
-			do
+			dword sample_value;
+			sample_value =	((s2_l + val_l) >> 16) +
+							((s2_r + val_r) & 0xFFFF0000); // save s2+val
+
+			dstpos->sample = sample_value;
+			dstpos++;
+			if(dstpos - buffer >= BUFFER_LEN)
 			{
-				dword sample_value;
-				sample_value =	((s2_l + val_l) >> 16) +
-								((s2_r + val_r) & 0xFFFF0000); // save s2+val
-
-				dstpos->sample = sample_value;
-				dstpos++;
-				if(dstpos - buffer >= BUFFER_LEN)
-				{
-					dstpos = buffer;
-				}
-
-				tick += TICK_F;
-				s2_l = val_l;
-				s2_r = val_r; // s2=s1, s1=0;
-
-			} while ((endtick ^ tick) & ~(TICK_F-1));
+				dstpos = buffer;
+			}
+
+			// s2=s1, s1=0 - the rest of samples till endtick are the same
+			s2_l = val_l;
+			s2_r = val_r;
+			dword count = (((endtick & ~(TICK_F-1)) - tick) >> TICK_FF) - 1;
+			if(count)
+			{
+				Fill(((s2_l + val_l) >> 16) + ((s2_r + val_r) & 0xFFFF0000), count);
+			}
 		}
 
 		tick = endtick;
@@ -228,3 +304,22 @@ static struct eFilterDiffInit
 		}
 	}
 } fdi;
+//=============================================================================
+//	eSoundEdges::Flush
+//-----------------------------------------------------------------------------
+void eSoundEdges::Flush(eDeviceSound* sound)
+{
+	if(sound->skip) // no samples, only final level matters
+	{
+		if(count)
+			sound->mix_l = sound->mix_r = edges[count - 1].level;
+		count = 0;
+		return;
+	}
+	const eEdge* e = edges;
+	for(int i = count; --i >= 0; ++e)
+	{
+		sound->Update(e->tact, e->level, e->level);
+	}
+	count = 0;
+}
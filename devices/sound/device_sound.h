@@ -51,19 +51,61 @@ public:
 	dword AudioDataReady();
 	void AudioDataUse(dword size);
 
+	virtual void Skip(bool on) { skip = on; } // keep time only, no samples (fast forward)
+
 protected:
+	void AudioDataPublish();
+	friend class eSoundEdges;
+
 	dword mix_l, mix_r;
 	SNDSAMPLE* dstpos;
+	SNDSAMPLE* readypos;	// given out up to it if deferred
 	dword clock_rate, sample_rate;
+	bool skip;
+	bool deferred;			// synthesis runs in other thread, samples are given out when published
+	bool used;				// given out samples are taken, drop them on publish
 
 	SNDSAMPLE buffer[BUFFER_LEN];
 
 private:
 	dword tick, base_tick;
+	dword tick_mul, tick_div, tacts_max;
 	dword s1_l, s1_r;
 	dword s2_l, s2_r;
 
+	dword Ticks(dword tacts) const;
 	void Flush(dword endtick);
+	void Fill(dword sample_value, dword count);
+};
+
+//=============================================================================
+//	eSoundEdges
+//-----------------------------------------------------------------------------
+// mono level changes of sound device logged during frame, filtered all at once
+// by Flush() (at frame end), held by devices changing level often (beeper, tape)
+class eSoundEdges
+{
+public:
+	eSoundEdges() : count(0) {}
+	void Add(eDeviceSound* sound, dword tact, dword level)
+	{
+		if(count == MAX)
+			Flush(sound);
+		eEdge& e = edges[count++];
+		e.tact = tact;
+		e.level = level;
+	}
+	void Flush(eDeviceSound* sound);
+
+protected:
+	struct eEdge
+	{
+		dword	tact;
+		dword	level;
+	};
+	enum { MAX = 8192 };
+	int		count;
+	eEdge	edges[MAX];
 };
 
 #endif//__DEVICE_SOUND_H__
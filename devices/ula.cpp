@@ -28,17 +28,22 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 //	eUla::eUla
 //-----------------------------------------------------------------------------
 eUla::eUla(eMemory* m) : memory(m), border_color(0), first_screen(true), base(NULL)
-	, colortab(NULL), timing(NULL), prev_t(0), frame(0), mode_48k(false)
+	, colortab(NULL), timing(NULL), prev_t(0), bus_timing(NULL), bus_t(0), frame(0)
+	, mode_48k(false), skip(false), events(logs[0]), events_count(0), draw_events(logs[1])
+	, draw_events_count(0), draw_t(0), draw_skip(false), drawn(false), draw_base(NULL)
+	, draw_border(0), thread(NULL)
 {
-	screen = new byte[S_WIDTH * S_HEIGHT];
-	memset(screen, 0, S_WIDTH * S_HEIGHT);
+	screens = new byte[2 * S_WIDTH * S_HEIGHT];
+	memset(screens, 0, 2 * S_WIDTH * S_HEIGHT);
+	screen = draw_screen = screens;
 }
 //=============================================================================
 //	eUla::~eUla
 //-----------------------------------------------------------------------------
 eUla::~eUla()
 {
-	delete[] screen;
+	SAFE_DELETE(thread);
+	delete[] screens;
 }
 //=============================================================================
 //	eUla::Init
@@ -50,10 +55,13 @@ void eUla::Init()
 	paper_start	= 17989;
 	prev_t = 0;
 	timing = timings;
+	bus_t = 0;
+	bus_timing = timings;
 	colortab = colortab1;
 	CreateTables();
 	CreateTimings();
 	base = memory->Get(eMemory::P_RAM5);
+	draw_base = screen_copy[0];
 }
 //=============================================================================
 //	eUla::CreateTables
@@ -116,7 +124,7 @@ void eUla::CreateTimings()
 	int line_t = paper_start - b_top * line_tacts - b_left / 2;
 	for(int i = 0; i < b_top; ++i) // top border
 	{
-		byte* dst = screen + scr_width * i;
+		int dst = scr_width * i;
 		timings[idx++].Set(Max(line_t, 0), eTiming::Z_BORDER, dst);
 
 		int t = Max(line_t + (b_left + buf_mid + b_right) / 2, 0);
@@ -125,15 +133,15 @@ void eUla::CreateTimings()
 	}
 	for(int i = 0; i < mid_lines; ++i) // screen + border
 	{
-		byte* dst = screen + scr_width * (i + b_top);
+		int dst = scr_width * (i + b_top);
 		timings[idx++].Set(Max(line_t, 0), eTiming::Z_BORDER, dst);
 
 		int t = Max(line_t + b_left / 2, 0);
-		dst = screen + scr_width * (i + b_top) + b_left;
+		dst = scr_width * (i + b_top) + b_left;
 		timings[idx++].Set(t, eTiming::Z_PAPER, dst, scrtab[i], atrtab[i]);
 
 		t = Max(line_t + (b_left + buf_mid) / 2, 0);
-		dst = screen + scr_width * (i + b_top) + b_left + buf_mid;
+		dst = scr_width * (i + b_top) + b_left + buf_mid;
 		timings[idx++].Set(t, eTiming::Z_BORDER, dst);
 
 		t = Max(line_t + (b_left + buf_mid + b_right) / 2, 0);
@@ -142,7 +150,7 @@ void eUla::CreateTimings()
 	}
 	for(int i = 0; i < b_bottom; ++i) // bottom border
 	{
-		byte* dst = screen + scr_width * (i + b_top + mid_lines);
+		int dst = scr_width * (i + b_top + mid_lines);
 		timings[idx++].Set(Max(line_t, 0), eTiming::Z_BORDER, dst);
 
 		int t = Max(line_t + (b_left + buf_mid + b_right) / 2, 0);
@@ -165,39 +173,45 @@ void eUla::SwitchScreen(bool first, int tact)
 {
 	if(first == first_screen)
 		return;
-	UpdateRay(tact);
+	Event(tact, eEvent::E_SCREEN, 0, first);
 	first_screen = first;
 	int page = first_screen ? eMemory::P_RAM5: eMemory::P_RAM7;
 	base = memory->Get(page);
 }
 //=============================================================================
-//	eUla::IoRead
+//	eUla::IoReadDecode
 //-----------------------------------------------------------------------------
-bool eUla::IoRead(word port) const
+int eUla::IoReadDecode(eIoDecode* d) const
 {
-	return (port&0xff) == 0xff;
+	static const eIoDecode ports[] = { { 0x00ff, 0x00ff, false } };	// #ff
+	return IoDecode(d, ports, 1);
 }
 //=============================================================================
-//	eUla::IoWrite
+//	eUla::IoWriteDecode
 //-----------------------------------------------------------------------------
-bool eUla::IoWrite(word port) const
+int eUla::IoWriteDecode(eIoDecode* d) const
 {
-	return !(port&1) || (!mode_48k && !(port & 2) && !(port & 0x8000));
+	static const eIoDecode ports[] =
+	{
+		{ 0x0001, 0x0000, false },	// #fe
+		{ 0x8002, 0x0000, false },	// #7ffd, zx128 only
+	};
+	return IoDecode(d, ports, mode_48k ? 1 : 2);
 }
 //=============================================================================
 //	eUla::IoRead
 //-----------------------------------------------------------------------------
 void eUla::IoRead(word port, byte* v, int tact)
 {
-	UpdateRay(tact);
-	if(timing->zone != eTiming::Z_PAPER) // ray is not in paper
+	UpdateBusRay(tact);
+	if(bus_timing->zone != eTiming::Z_PAPER) // ray is not in paper
 	{
 		*v = 0xff;
 		return;
 	}
 	int t = tact;
-	int offs = (t - timing->t) / 4;
-	byte* atr = base + timing->attr_offs + offs;
+	int offs = (t - bus_timing->t) / 4;
+	byte* atr = base + bus_timing->attr_offs + offs;
 	*v = *atr;
 }
 //=============================================================================
@@ -209,7 +223,7 @@ void eUla::IoWrite(word port, byte v, int tact)
 	{
 		if((v & 7) != border_color)
 		{
-			UpdateRay(tact);
+			Event(tact, eEvent::E_BORDER, 0, v & 7);
 			border_color = v & 7;
 		}
 	}
@@ -223,9 +237,146 @@ void eUla::IoWrite(word port, byte v, int tact)
 //-----------------------------------------------------------------------------
 void eUla::FrameUpdate()
 {
-	UpdateRay(0x7fff0000);
+	Render(FRAME_END);
+	bus_t = 0;
+	bus_timing = timings;
+	if(thread)
+		thread->Start(this);
+	else
+		Execute();
+}
+//=============================================================================
+//	eUla::Threaded
+//-----------------------------------------------------------------------------
+void eUla::Threaded(bool on)
+{
+	if(on == (thread != NULL))
+		return;
+	if(thread)
+	{
+		RenderWait();
+		SAFE_DELETE(thread);
+		draw_screen = screen;
+	}
+	else
+	{
+		thread = new eJobThread;
+		drawn = false;
+		draw_screen = screen == screens ? screens + S_WIDTH * S_HEIGHT : screens;
+	}
+}
+//=============================================================================
+//	eUla::WriteScreen
+//-----------------------------------------------------------------------------
+// log cpu writes into ram5/ram7 screen to draw them in time
+void eUla::WriteScreen(word addr, byte v, int tact)
+{
+	byte* a = memory->Bank(addr >> 14) + (addr & 0x3fff);
+	int offs = a - memory->Get(eMemory::P_RAM5);
+	if(offs < 0 || offs >= SCREEN_SIZE)
+	{
+		offs = a - memory->Get(eMemory::P_RAM7);
+		if(offs < 0 || offs >= SCREEN_SIZE)
+			return;
+		offs += SCREEN_SIZE;
+	}
+	if(*a != v)
+		Event(tact, offs, *a, v);
+}
+//=============================================================================
+//	eUla::Event
+//-----------------------------------------------------------------------------
+void eUla::Event(int tact, word offs, byte old, byte v)
+{
+	if(events_count == EVENTS_MAX)
+	{
+		Render(tact);
+		Execute();
+	}
+	eEvent& e = events[events_count++];
+	e.t = tact;
+	e.offs = offs;
+	e.old = old;
+	e.v = v;
+}
+//=============================================================================
+//	eUla::Render
+//-----------------------------------------------------------------------------
+// hand events logged up to tact to draw, screens are taken from memory as they are
+// now (logged writes are rolled back when drawn to get what ray saw before)
+//-----------------------------------------------------------------------------
+void eUla::Render(int tact)
+{
+	RenderWait();
+	eEvent* e = draw_events;
+	draw_events = events;
+	draw_events_count = events_count;
+	events = e;
+	events_count = 0;
+	draw_t = tact;
+	draw_skip = skip;
+	if(skip)
+	{
+		draw_base = screen_copy[first_screen ? 0 : 1];
+		draw_border = border_color;
+		return;
+	}
+	memcpy(screen_copy[0], memory->Get(eMemory::P_RAM5), SCREEN_SIZE);
+	if(!mode_48k)
+		memcpy(screen_copy[1], memory->Get(eMemory::P_RAM7), SCREEN_SIZE);
+}
+//=============================================================================
+//	eUla::RenderWait
+//-----------------------------------------------------------------------------
+// wait for background drawing, show picture if the whole one is ready
+void eUla::RenderWait()
+{
+	if(!thread)
+		return;
+	thread->Wait();
+	if(drawn)
+	{
+		byte* s = screen;
+		screen = draw_screen;
+		draw_screen = s;
+		drawn = false;
+	}
+}
+//=============================================================================
+//	eUla::Execute
+//-----------------------------------------------------------------------------
+// draw handed events in time (in render thread if threaded)
+void eUla::Execute()
+{
+	if(!draw_skip)
+	{
+		byte* copy = screen_copy[0];
+		for(int i = draw_events_count; --i >= 0; )
+		{
+			const eEvent& e = draw_events[i];
+			if(e.offs < eEvent::E_BORDER)
+				copy[e.offs] = e.old;
+		}
+		for(int i = 0; i < draw_events_count; ++i)
+		{
+			const eEvent& e = draw_events[i];
+			if(prev_t < e.t)
+				UpdateRay(e.t);
+			switch(e.offs)
+			{
+			case eEvent::E_BORDER:	draw_border = e.v;						break;
+			case eEvent::E_SCREEN:	draw_base = screen_copy[e.v ? 0 : 1];	break;
+			default:				copy[e.offs] = e.v;						break;
+			}
+		}
+		UpdateRay(draw_t);
+	}
+	draw_events_count = 0;
+	if(draw_t != FRAME_END)
+		return;
 	prev_t = 0;
 	timing = timings;
+	drawn = !draw_skip;
 	if(++frame >= 15)
 	{
 		frame = 0;
@@ -265,12 +416,12 @@ void eUla::UpdateRay(int tact)
 void eUla::UpdateRayBorder(int& t, int last_t)
 {
 	int offs = (t - timing->t) * 2;
-	byte* dst = timing->dst + offs;
+	byte* dst = draw_screen + timing->dst + offs;
 	int end = Min(last_t, (timing + 1)->t);
 	for(; t < end; ++t)
 	{
-		*dst++ = border_color;
-		*dst++ = border_color;
+		*dst++ = draw_border;
+		*dst++ = draw_border;
 	}
 }
 //=============================================================================
@@ -279,9 +430,9 @@ void eUla::UpdateRayBorder(int& t, int last_t)
 void eUla::UpdateRayPaper(int& t, int last_t)
 {
 	int offs = (t - timing->t) / 4;
-	byte* scr = base + timing->scr_offs + offs;
-	byte* atr = base + timing->attr_offs + offs;
-	byte* dst = timing->dst + offs * 8;
+	byte* scr = draw_base + timing->scr_offs + offs;
+	byte* atr = draw_base + timing->attr_offs + offs;
+	byte* dst = draw_screen + timing->dst + offs * 8;
 	int end = Min(last_t, (timing + 1)->t);
 	for(int i = 0; t < end; ++i)
 	{
@@ -297,6 +448,35 @@ void eUla::UpdateRayPaper(int& t, int last_t)
 	}
 }
 //=============================================================================
+//	eUla::UpdateBusRay
+//-----------------------------------------------------------------------------
+// move ray without drawing, it stops where drawing would (paper is drawn by 4 tacts)
+void eUla::UpdateBusRay(int tact)
+{
+	int t = bus_t;
+	while(t < tact)
+	{
+		int end = Min(tact, (bus_timing + 1)->t);
+		switch(bus_timing->zone)
+		{
+		case eTiming::Z_SHADOW:
+			t = (bus_timing + 1)->t;
+			break;
+		case eTiming::Z_BORDER:
+			t = end;
+			break;
+		case eTiming::Z_PAPER:
+			t += (end - t + 3) & ~3;
+			break;
+		}
+		if(t == (bus_timing + 1)->t)
+		{
+			bus_timing++;
+		}
+	}
+	bus_t = t;
+}
+//=============================================================================
 //	eUla::FlushScreen
 //-----------------------------------------------------------------------------
 void eUla::FlushScreen()
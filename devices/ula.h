@@ -20,6 +20,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define	__ULA_H__
 
 #include "device.h"
+#include "../tools/job_thread.h"
 
 #pragma once
 
@@ -28,7 +29,7 @@ class eMemory;
 //*****************************************************************************
 //	eUla
 //-----------------------------------------------------------------------------
-class eUla : public eDevice
+class eUla : public eDevice, public eJobThread::eJob
 {
 public:
 	eUla(eMemory* m);
@@ -36,17 +37,23 @@ public:
 	virtual void Init();
 	virtual void Reset();
 	virtual void FrameUpdate();
-	virtual bool IoRead(word port) const;
-	virtual bool IoWrite(word port) const;
+	virtual int IoReadDecode(eIoDecode* d) const;
+	virtual int IoWriteDecode(eIoDecode* d) const;
 	virtual void IoRead(word port, byte* v, int tact);
 	virtual void IoWrite(word port, byte v, int tact);
-	void	Write(int tact) { if(prev_t < tact) UpdateRay(tact); }
+	void	Write(word addr, byte v, int tact)
+	{
+		if((addr & 0x4000) && (addr & 0x3fff) < SCREEN_SIZE) // #4000-#5aff, #c000-#daff
+			WriteScreen(addr, v, tact);
+	}
 
 	void*	Screen() const { return screen; }
 
 	byte	BorderColor() const { return border_color; }
 	bool	FirstScreen() const { return first_screen; }
 	void	Mode48k(bool on)	{ mode_48k = on; }
+	void	Skip(bool on)		{ skip = on; } // drop frame events without drawing (fast forward)
+	void	Threaded(bool on);	// draw frame in background while cpu runs the next one
 
 	static eDeviceId Id() { return D_ULA; }
 	virtual dword IoNeed() const { return ION_WRITE|ION_READ; }
@@ -54,16 +61,23 @@ protected:
 	void	CreateTables();
 	void	CreateTimings();
 	void	SwitchScreen(bool first, int tact);
+	void	WriteScreen(word addr, byte v, int tact);
+	void	Event(int tact, word offs, byte old, byte v);
+	void	Render(int tact);
+	void	RenderWait();
+	virtual void Execute();
 	void	UpdateRay(int tact);
 	void	UpdateRayBorder(int& t, int last_t);
 	void	UpdateRayPaper(int& t, int last_t);
+	void	UpdateBusRay(int tact);
 	void	FlushScreen();
 
 	enum eScreen { S_WIDTH = 320, S_HEIGHT = 240, SZX_WIDTH = 256, SZX_HEIGHT = 192 };
+	enum { SCREEN_SIZE = 6912, EVENTS_MAX = 8192, FRAME_END = 0x7fff0000 };
 	struct eTiming
 	{
 		enum eZone { Z_SHADOW, Z_BORDER, Z_PAPER };
-		void Set(int _t, eZone _zone = Z_SHADOW, byte* _dst = NULL
+		void Set(int _t, eZone _zone = Z_SHADOW, int _dst = 0
 			, int _scr_offs = 0, int _attr_offs = 0)
 		{
 			dst			= _dst;
@@ -72,12 +86,21 @@ protected:
 			scr_offs	= _scr_offs;
 			attr_offs	= _attr_offs;
 		}
-		byte*	dst;		// screen raster pointer
+		int		dst;		// screen raster offset
 		int		t;			// start zone tact
 		eZone	zone;		// what are drawing: shadow/border/screen
 		int		scr_offs;
 		int		attr_offs;
 	};
+	// changes seen by ray during frame, drawn all at once by Render()
+	struct eEvent
+	{
+		enum { E_BORDER = 0xfffe, E_SCREEN = 0xffff }; // offs for non-write events
+		int		t;
+		word	offs;		// written byte offset in screen_copy
+		byte	old;
+		byte	v;			// new byte / border color / first screen
+	};
 protected:
 	eMemory* memory;
 	int		line_tacts;		// t-states per line
@@ -85,7 +108,9 @@ protected:
 	byte	border_color;
 	bool	first_screen;
 	byte*	base;
-	byte*	screen;
+	byte*	screens;		// two pictures
+	byte*	screen;			// last drawn picture
+	byte*	draw_screen;	// picture being drawn (other one if threaded)
 	int		scrtab[256];	// offset to start of line
 	int		atrtab[256];	// offset to start of attribute line
 	byte	colortab1[256];	// map zx attributes to pc attributes
@@ -95,8 +120,24 @@ protected:
 	eTiming	timings[4 * S_HEIGHT];
 	eTiming* timing;
 	int		prev_t;			// last drawn pixel's tact
+	eTiming* bus_timing;	// ray position seen by floating bus
+	int		bus_t;
 	int		frame;
 	bool	mode_48k;
+	bool	skip;
+
+	eEvent	logs[2][EVENTS_MAX];
+	eEvent*	events;			// logged during frame
+	int		events_count;
+	eEvent*	draw_events;	// handed to draw
+	int		draw_events_count;
+	int		draw_t;			// draw up to
+	bool	draw_skip;
+	bool	drawn;			// whole draw_screen picture is ready
+	byte	screen_copy[2][SCREEN_SIZE];	// ram5/ram7 screens as ray sees them
+	byte*	draw_base;
+	byte	draw_border;
+	eJobThread* thread;
 };
 
 #endif//__ULA_H__
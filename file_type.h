@@ -20,6 +20,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define __FILE_TYPE_H__
 
 #include "tools/list.h"
+#include "platform/io.h"
 
 #pragma once
 
@@ -29,6 +30,9 @@ namespace xPlatform
 struct eFileType : public eList<eFileType>
 {
 	virtual bool Open(const char *name, const void* data, size_t data_size) = 0;
+	// override to keep reference to file data instead of copying it
+	virtual bool OpenData(const char *name, xIo::eFileData* file) { return Open(name, file->Data(), file->Size()); }
+
 	virtual bool Store(const char* name) { return false; }
 	virtual bool AbleOpen() { return true; }
 	virtual const char* Type() = 0;
@@ -24,13 +24,22 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "platform/io.h"
 #include "tools/stream_memory.h"
 #include "file_type.h"
+#include "file_type_zip.h"
+#include <ctype.h>
 
 namespace xPlatform
 {
 
 static struct eFileTypeZIP : public eFileType
 {
-	virtual bool Open(const char *name, const void* data, size_t data_size);
+	virtual bool Open(const char *name, const void* data, size_t data_size)
+	{
+		xIo::eFileData* f = xIo::eFileData::Copy(data, data_size);
+		bool ok = OpenData(name, f);
+		f->Release();
+		return ok;
+	}
+	virtual bool OpenData(const char *name, xIo::eFileData* file);
 	virtual const char* Type() { return "zip"; }
 } ft_zip;
 
@@ -69,50 +78,247 @@ static int ZClose(voidpf opaque, voidpf stream)
 	return f->Close();
 }
 
-bool eFileTypeZIP::Open(const char *name, const void* data, size_t data_size)
-{
-	xIo::eStreamMemory mf(data, data_size);
-	zlib_filefunc64_def zfuncs;
-	zfuncs.zopen64_file = ZOpen;
-	zfuncs.zread_file = ZRead;
-	zfuncs.ztell64_file = ZTell;
-	zfuncs.zseek64_file = ZSeek;
-	zfuncs.zclose_file = ZClose;
+class eZipFile
+{
+public:
+	eZipFile(xIo::eFileData* file) : stream(file->Data(), file->Size())
+	{
+		zlib_filefunc64_def zfuncs;
+		zfuncs.zopen64_file = ZOpen;
+		zfuncs.zread_file = ZRead;
+		zfuncs.ztell64_file = ZTell;
+		zfuncs.zseek64_file = ZSeek;
+		zfuncs.zclose_file = ZClose;
+		zfuncs.zerror_file = NULL;
+		zfuncs.opaque = NULL;
+		h = unzOpen2_64(&stream, &zfuncs);
+	}
+	~eZipFile() { if(h) unzClose(h); }
+	unzFile h;
+protected:
+	xIo::eStreamMemory stream;
+};
+
+static eZipDir* zip_cache[eZipDir::CACHE_SIZE] = { NULL };
+static int zip_cache_next = 0;
 
-	unzFile h = unzOpen2_64(&mf, &zfuncs);
-	if(!h)
+//=============================================================================
+//	eZipDir::eZipDir
+//-----------------------------------------------------------------------------
+eZipDir::eZipDir(const char* _path, xIo::eFileData* file) : path(_path), size(file->Size())
+{
+	memset(key, 0, sizeof(key));
+	size_t key_size = size < KEY_SIZE ? size : KEY_SIZE;
+	memcpy(key, file->Data() + size - key_size, key_size);
+}
+//=============================================================================
+//	eZipDir::Same
+//-----------------------------------------------------------------------------
+bool eZipDir::Same(xIo::eFileData* f) const
+{
+	if(f->Size() != size)
 		return false;
-	bool ok = false;
-	if(unzGoToFirstFile(h) == UNZ_OK)
+	size_t key_size = size < KEY_SIZE ? size : KEY_SIZE;
+	return !memcmp(key, f->Data() + size - key_size, key_size);
+}
+//=============================================================================
+//	eZipDir::Parse
+//-----------------------------------------------------------------------------
+bool eZipDir::Parse(xIo::eFileData* file)
+{
+	eZipFile z(file);
+	if(!z.h)
+		return false;
+	if(unzGoToFirstFile(z.h) != UNZ_OK)
+		return true;
+	do
 	{
-		for(;;)
+		unz_file_info64 fi;
+		char n[xIo::MAX_PATH_LEN];
+		unz64_file_pos pos;
+		if(unzGetCurrentFileInfo64(z.h, &fi, n, xIo::MAX_PATH_LEN, NULL, 0, NULL, 0) != UNZ_OK ||
+			unzGetFilePos64(z.h, &pos) != UNZ_OK)
+			return false;
+		eMember m;
+		m.name = n;
+		m.size = fi.uncompressed_size;
+		m.dir_pos = pos.pos_in_zip_directory;
+		m.num = pos.num_of_file;
+		members.push_back(m);
+	}
+	while(unzGoToNextFile(z.h) == UNZ_OK);
+	return true;
+}
+//=============================================================================
+//	eZipDir::Open
+//-----------------------------------------------------------------------------
+const eZipDir* eZipDir::Open(const char* path, xIo::eFileData* file)
+{
+	for(int i = 0; i < CACHE_SIZE; ++i)
+	{
+		eZipDir* d = zip_cache[i];
+		if(d && d->path == path)
 		{
-			unz_file_info fi;
-			char n[xIo::MAX_PATH_LEN];
-			if(unzGetCurrentFileInfo(h, &fi, n, xIo::MAX_PATH_LEN, NULL, 0, NULL, 0) == UNZ_OK)
-			{
-				eFileType* t = eFileType::FindByName(n);
-				if(t)
-				{
-					if(unzOpenCurrentFile(h) == UNZ_OK)
-					{
-						byte* buf = new byte[fi.uncompressed_size];
-						if(unzReadCurrentFile(h, buf, fi.uncompressed_size) == int(fi.uncompressed_size))
-						{
-							ok = t->Open(name, buf, fi.uncompressed_size);
-						}
-						delete[] buf;
-						unzCloseCurrentFile(h);
-					}
-				}
-			}
-			if(ok)
-				break;
-			if(unzGoToNextFile(h) == UNZ_END_OF_LIST_OF_FILE)
-				break;
+			if(d->Same(file))
+				return d;
+			delete d; // archive was changed
+			zip_cache[i] = NULL;
 		}
 	}
-	unzClose(h);
+	eZipDir* d = OpenUncached(path, file);
+	if(!d)
+		return NULL;
+	delete zip_cache[zip_cache_next];
+	zip_cache[zip_cache_next] = d;
+	zip_cache_next = (zip_cache_next + 1) % CACHE_SIZE;
+	return d;
+}
+const eZipDir* eZipDir::Open(const char* path)
+{
+	xIo::eFileData* f = xIo::eFileData::Open(path);
+	if(!f)
+		return NULL;
+	const eZipDir* d = Open(path, f);
+	f->Release();
+	return d;
+}
+//=============================================================================
+//	eZipDir::OpenUncached
+//-----------------------------------------------------------------------------
+eZipDir* eZipDir::OpenUncached(const char* path, xIo::eFileData* file)
+{
+	eZipDir* d = new eZipDir(path, file);
+	if(!d->Parse(file))
+	{
+		delete d;
+		return NULL;
+	}
+	return d;
+}
+//=============================================================================
+//	eZipDir::Find
+//-----------------------------------------------------------------------------
+int eZipDir::Find(const char* name) const
+{
+	for(int i = 0; i < Members(); ++i)
+	{
+		if(members[i].name == name)
+			return i;
+	}
+	return -1;
+}
+//=============================================================================
+//	eZipDir::FindSupported
+//-----------------------------------------------------------------------------
+int eZipDir::FindSupported() const
+{
+	for(int i = 0; i < Members(); ++i)
+	{
+		if(eFileType::FindByName(Name(i)))
+			return i;
+	}
+	return -1;
+}
+//=============================================================================
+//	eZipDir::Inflate
+//-----------------------------------------------------------------------------
+xIo::eFileData* eZipDir::Inflate(int i) const
+{
+	xIo::eFileData* archive = xIo::eFileData::Open(path.c_str());
+	if(!archive)
+		return NULL;
+	xIo::eFileData* f = Inflate(i, archive);
+	archive->Release();
+	return f;
+}
+//-----------------------------------------------------------------------------
+// whole member is inflated to memory, as file types take complete data. its
+// size comes from central directory, so it's limited to not allocate anything
+//-----------------------------------------------------------------------------
+xIo::eFileData* eZipDir::Inflate(int i, xIo::eFileData* archive) const
+{
+	if(!Same(archive) || members[i].size > MEMBER_SIZE_MAX)
+		return NULL;
+	eZipFile z(archive);
+	if(!z.h)
+		return NULL;
+	unz64_file_pos pos;
+	pos.pos_in_zip_directory = members[i].dir_pos;
+	pos.num_of_file = members[i].num;
+	if(unzGoToFilePos64(z.h, &pos) != UNZ_OK || unzOpenCurrentFile(z.h) != UNZ_OK)
+		return NULL;
+	// inflate right into the data buffer by limited portions (unzReadCurrentFile takes unsigned)
+	enum { CHUNK_SIZE = 65536 };
+	xIo::eFileData* f = xIo::eFileData::Create(members[i].size);
+	size_t done = 0;
+	while(done < f->Size())
+	{
+		size_t size = f->Size() - done;
+		if(size > CHUNK_SIZE)
+			size = CHUNK_SIZE;
+		int r = unzReadCurrentFile(z.h, f->Buffer() + done, size);
+		if(r <= 0)
+			break;
+		done += r;
+	}
+	if(unzCloseCurrentFile(z.h) != UNZ_OK || done != f->Size())
+	{
+		f->Release();
+		return NULL;
+	}
+	return f;
+}
+//=============================================================================
+//	eZipDir::SplitPath
+//-----------------------------------------------------------------------------
+bool eZipDir::SplitPath(const char* path, char* archive, const char** member)
+{
+	for(const char* p = path + strlen(path); --p >= path; )
+	{
+		if(*p != '/' || p - path < 4)
+			continue;
+		const char* ext = p - 4;
+		if(ext[0] == '.' && tolower(ext[1]) == 'z' && tolower(ext[2]) == 'i' && tolower(ext[3]) == 'p')
+		{
+			memcpy(archive, path, p - path);
+			archive[p - path] = '\0';
+			*member = p + 1;
+			return true;
+		}
+	}
+	return false;
+}
+//=============================================================================
+//	OpenZipMember
+//-----------------------------------------------------------------------------
+xIo::eFileData* OpenZipMember(const char* path)
+{
+	char archive[xIo::MAX_PATH_LEN];
+	const char* member;
+	if(!eZipDir::SplitPath(path, archive, &member))
+		return NULL;
+	const eZipDir* d = eZipDir::Open(archive);
+	if(!d)
+		return NULL;
+	int i = d->Find(member);
+	return i >= 0 ? d->Inflate(i) : NULL;
+}
+//=============================================================================
+//	eFileTypeZIP::OpenData
+//-----------------------------------------------------------------------------
+bool eFileTypeZIP::OpenData(const char *name, xIo::eFileData* file)
+{
+	const eZipDir* d = eZipDir::Open(name, file);
+	if(!d)
+		return false;
+	int i = d->FindSupported();
+	if(i < 0)
+		return false;
+	xIo::eFileData* f = d->Inflate(i, file);
+	if(!f)
+		return false;
+	bool ok = FindByName(d->Name(i))->OpenData(name, f);
+	f->Release();
 	return ok;
 }
 
@@ -0,0 +1,87 @@
+/*
+Portable ZX-Spectrum emulator.
+Copyright (C) 2001-2012 SMT, Dexus, Alone Coder, deathsoft, djdron, scor
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __FILE_TYPE_ZIP_H__
+#define __FILE_TYPE_ZIP_H__
+
+#include <string>
+#include <vector>
+#include "platform/io.h"
+
+#pragma once
+
+#ifdef USE_ZIP
+
+namespace xPlatform
+{
+
+//*****************************************************************************
+//	eZipDir
+//-----------------------------------------------------------------------------
+// parsed central directory of zip archive, kept in cache until archive
+// changes, so browsing/opening members doesn't walk through all entries.
+// archive data itself isn't kept, it's opened again to inflate a member
+//-----------------------------------------------------------------------------
+class eZipDir
+{
+public:
+	enum { CACHE_SIZE = 8 }; // archives kept parsed
+	enum { MEMBER_SIZE_MAX = 16*1024*1024 }; // larger members aren't inflated
+	static const eZipDir* Open(const char* path);
+	static const eZipDir* Open(const char* path, xIo::eFileData* file);
+	// not put into cache, so may be used outside of main thread. delete it after use
+	static eZipDir* OpenUncached(const char* path, xIo::eFileData* file);
+
+	int Members() const					{ return members.size(); }
+	const char* Name(int i) const		{ return members[i].name.c_str(); }
+	size_t Size(int i) const			{ return members[i].size; }
+	int Find(const char* name) const;	// -1 if not found
+	int FindSupported() const;			// first member with known file type
+	xIo::eFileData* Inflate(int i) const; // archive is opened by path
+	xIo::eFileData* Inflate(int i, xIo::eFileData* archive) const;
+
+	// "dir/archive.zip/member" -> "dir/archive.zip", "member"
+	static bool SplitPath(const char* path, char* archive, const char** member);
+
+protected:
+	eZipDir(const char* path, xIo::eFileData* file);
+	bool Parse(xIo::eFileData* file);
+	bool Same(xIo::eFileData* file) const;
+
+	enum { KEY_SIZE = 64 };
+	struct eMember
+	{
+		std::string name;
+		size_t	size;
+		qword	dir_pos;	// position of entry in central directory
+		qword	num;		// index of entry
+	};
+	std::string path;
+	size_t	size;			// archive size
+	byte	key[KEY_SIZE];	// archive tail (end of central dir record) to detect changes
+	std::vector<eMember> members;
+};
+
+xIo::eFileData* OpenZipMember(const char* path);
+
+}
+//namespace xPlatform
+
+#endif//USE_ZIP
+
+#endif//__FILE_TYPE_ZIP_H__
@@ -97,6 +97,31 @@ static struct eOptionTape : public xOptions::eOptionInt
 	virtual int Order() const { return 40; }
 } op_tape;
 
+static struct eOptionReplaySeek : public xOptions::eOptionB
+{
+	eOptionReplaySeek() { storeable = false; }
+	virtual const char* Name() const { return "rzx seek"; }
+	virtual const char* Value() const
+	{
+		int frame = Handler()->ReplayFrame();
+		if(frame < 0)
+			return "n/a";
+		static char time[16];
+		sprintf(time, "%d:%02d", frame/50/60, frame/50%60);
+		return time;
+	}
+	virtual void Change(bool next = true)
+	{
+		enum { SEEK_FRAMES = 10*50 };
+		int frame = Handler()->ReplayFrame();
+		if(frame < 0)
+			return;
+		frame += next ? SEEK_FRAMES : -SEEK_FRAMES;
+		Handler()->OnReplaySeek(frame > 0 ? frame : 0);
+	}
+	virtual int Order() const { return 41; }
+} op_replay_seek;
+
 static struct eOptionPause : public xOptions::eOptionBool
 {
 	eOptionPause() { storeable = false; }
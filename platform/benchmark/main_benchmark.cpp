@@ -23,16 +23,21 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 int main(int argc, char* argv[])
 {
-	if(argc != 2)
+	if(argc < 2 || argc > 4)
 	{
-		printf("Usage : %s image_name\n", argv[0]);
+		printf("Usage : %s image_name [real_sec [trace_file]]\n", argv[0]);
 		return 1;
 	}
 	int r = 0;
 	using namespace xPlatform;
 	Handler()->OnInit();
-	const int benchmark_real_time = 600;
-	if(Handler()->OnOpenFile(argv[1]))
+	const int benchmark_real_time = argc > 2 ? atoi(argv[2]) : 600;
+	if(argc > 3 && !Handler()->OnTrace(argv[3]))
+	{
+		printf("Error : %s - unable to write trace\n", argv[3]);
+		r = 1;
+	}
+	else if(Handler()->OnOpenFile(argv[1]))
 	{
 		printf("Emulating %d real sec. (%d frames)...", benchmark_real_time, benchmark_real_time*50);
 		fflush(stdout);
@@ -0,0 +1,194 @@
+/*
+Portable ZX-Spectrum emulator.
+Copyright (C) 2001-2012 SMT, Dexus, Alone Coder, deathsoft, djdron, scor
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../../std.h"
+#include "ui_dir_scan.h"
+#include "../../tools/io_select.h"
+#include "../../tools/job_thread.h"
+
+#ifdef USE_UI
+
+#if defined(_LINUX) || defined(_POSIX)
+#include <sys/stat.h>
+#endif//_LINUX || _POSIX
+#include <time.h>
+#include <list>
+
+namespace xUi
+{
+
+enum { BATCH_SIZE = 64, CACHE_SIZE = 16 };
+
+struct eDirScanJob : public eJobThread::eJob
+{
+	eDirScanJob(const char* _path) : path(_path), done(false), cancel(false), refs(2) {}
+	virtual void Execute();
+	virtual void Release();
+	std::string path;
+	std::vector<eDirEntry> entries;
+	bool	done;
+	bool	cancel;
+	int		refs; // scanner & worker
+};
+
+struct eCached
+{
+	std::string path;
+	time_t	time;
+	std::vector<eDirEntry> entries;
+};
+static std::list<eCached> cache;
+
+// entries & flags of jobs and the cache are guarded by the lock of scan_thread,
+// it goes after the cache, so is destroyed first (finishing queued jobs)
+static eJobThread scan_thread;
+
+//=============================================================================
+//	DirTime
+//-----------------------------------------------------------------------------
+// 0 if unknown, such listings aren't cached
+static time_t DirTime(const char* path)
+{
+#if defined(_LINUX) || defined(_POSIX)
+	struct stat st;
+	if(stat(path, &st) == 0)
+		return st.st_mtime;
+#endif//_LINUX || _POSIX
+	return 0;
+}
+//=============================================================================
+//	eDirScanJob::Release
+//-----------------------------------------------------------------------------
+void eDirScanJob::Release()
+{
+	scan_thread.Lock();
+	cancel = true;
+	bool last = !--refs;
+	scan_thread.Unlock();
+	if(last)
+		delete this;
+}
+//=============================================================================
+//	eDirScanJob::Execute
+//-----------------------------------------------------------------------------
+void eDirScanJob::Execute()
+{
+	time_t dir_time = DirTime(path.c_str());
+	scan_thread.Lock();
+	if(cancel) // scanner gone before its turn came
+	{
+		scan_thread.Unlock();
+		return;
+	}
+	for(std::list<eCached>::iterator i = cache.begin(); dir_time && i != cache.end(); ++i)
+	{
+		if(i->path != path)
+			continue;
+		if(i->time == dir_time)
+		{
+			entries = i->entries;
+			done = true;
+			cache.splice(cache.begin(), cache, i);
+			scan_thread.Unlock();
+			return;
+		}
+		cache.erase(i); // directory was changed
+		break;
+	}
+	scan_thread.Unlock();
+
+	std::vector<eDirEntry> batch;
+	bool cancelled = false;
+	for(xIo::eFileSelect fs(path.c_str()); !cancelled && fs.Valid(); fs.Next())
+	{
+		if(fs.IsDir() && (!strcmp(fs.Name(), ".") || !strcmp(fs.Name(), "..")))
+			continue;
+		if(!fs.IsDir() && !fs.IsFile())
+			continue;
+		eDirEntry e;
+		e.name = fs.Name();
+		e.dir = fs.IsDir();
+		batch.push_back(e);
+		if(batch.size() < BATCH_SIZE)
+			continue;
+		scan_thread.Lock();
+		entries.insert(entries.end(), batch.begin(), batch.end());
+		cancelled = cancel;
+		scan_thread.Unlock();
+		batch.clear();
+	}
+	scan_thread.Lock();
+	entries.insert(entries.end(), batch.begin(), batch.end());
+	done = true;
+	// mtime has seconds resolution, directory modified just now may change unnoticed
+	bool cacheable = dir_time && dir_time < time(NULL) - 1;
+	if(cacheable && !cancel)
+	{
+		eCached c;
+		c.path = path;
+		c.time = dir_time;
+		cache.push_front(c);
+		cache.front().entries = entries;
+		if(cache.size() > CACHE_SIZE)
+			cache.pop_back();
+	}
+	scan_thread.Unlock();
+}
+
+//=============================================================================
+//	eDirScan::eDirScan
+//-----------------------------------------------------------------------------
+eDirScan::eDirScan(const char* path) : fetched(0)
+{
+	job = new eDirScanJob(path);
+	scan_thread.Push(job);
+}
+//=============================================================================
+//	eDirScan::~eDirScan
+//-----------------------------------------------------------------------------
+eDirScan::~eDirScan()
+{
+	job->Release();
+}
+//=============================================================================
+//	eDirScan::Done
+//-----------------------------------------------------------------------------
+bool eDirScan::Done() const
+{
+	scan_thread.Lock();
+	bool done = job->done && fetched == job->entries.size();
+	scan_thread.Unlock();
+	return done;
+}
+//=============================================================================
+//	eDirScan::Fetch
+//-----------------------------------------------------------------------------
+size_t eDirScan::Fetch(std::vector<eDirEntry>* entries)
+{
+	scan_thread.Lock();
+	size_t count = job->entries.size() - fetched;
+	entries->insert(entries->end(), job->entries.begin() + fetched, job->entries.end());
+	fetched = job->entries.size();
+	scan_thread.Unlock();
+	return count;
+}
+
+}
+//namespace xUi
+
+#endif//USE_UI
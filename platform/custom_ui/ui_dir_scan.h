@@ -0,0 +1,68 @@
+/*
+Portable ZX-Spectrum emulator.
+Copyright (C) 2001-2012 SMT, Dexus, Alone Coder, deathsoft, djdron, scor
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef	__UI_DIR_SCAN_H__
+#define	__UI_DIR_SCAN_H__
+
+#include <string>
+#include <vector>
+#include "../../ui/ui.h"
+
+#pragma once
+
+#ifdef USE_UI
+
+namespace xUi
+{
+
+struct eDirEntry
+{
+	std::string name;
+	bool	dir;
+};
+
+struct eDirScanJob;
+
+//*****************************************************************************
+//	eDirScan
+//-----------------------------------------------------------------------------
+// lists folders & files of directory in background thread (if available),
+// found entries may be fetched while scan is still in progress.
+// complete listings are cached until directory modification time changes
+//-----------------------------------------------------------------------------
+class eDirScan
+{
+public:
+	eDirScan(const char* path); // path with trailing slash
+	~eDirScan(); // cancels scan in progress
+
+	bool Done() const;
+	// appends entries found since last call, returns their count
+	size_t Fetch(std::vector<eDirEntry>* entries);
+
+protected:
+	eDirScanJob* job;
+	size_t fetched;
+};
+
+}
+//namespace xUi
+
+#endif//USE_UI
+
+#endif//__UI_DIR_SCAN_H__
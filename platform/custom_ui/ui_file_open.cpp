@@ -23,7 +23,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "../../tools/io_select.h"
 #include "../platform.h"
 #include "../../options_common.h"
+#include "../../file_type_zip.h"
 #include <ctype.h>
+#include <algorithm>
 
 #ifdef USE_UI
 
@@ -33,10 +35,16 @@ namespace xUi
 //=============================================================================
 //	eFileOpenDialog::eFileOpenDialog
 //-----------------------------------------------------------------------------
-eFileOpenDialog::eFileOpenDialog(const char* _path) : list(NULL), selected(NULL)
+eFileOpenDialog::eFileOpenDialog(const char* _path) : list(NULL), selected(NULL), scan(NULL)
 {
 	strcpy(path, _path);
-	memset(folders, 0, sizeof(folders));
+}
+//=============================================================================
+//	eFileOpenDialog::~eFileOpenDialog
+//-----------------------------------------------------------------------------
+eFileOpenDialog::~eFileOpenDialog()
+{
+	SAFE_DELETE(scan);
 }
 //=============================================================================
 //	eFileOpenDialog::Init
@@ -50,12 +58,12 @@ void eFileOpenDialog::Init()
 	list = new eList;
 	list->Bound() = eRect(margin.x, margin.y, r.Width() - margin.x, r.Height() - margin.y);
 	Insert(list);
-	OnChangePath();
 	int l = strlen(xPlatform::OpLastFolder());
 	if(l)
 	{
-		list->Item(xPlatform::OpLastFile() + l);
+		select_item = xPlatform::OpLastFile() + l; // selected once scan finds it
 	}
+	OnChangePath();
 }
 //=============================================================================
 //	StrCaseCmp
@@ -71,44 +79,132 @@ static int StrCaseCmp(const char* a, const char* b)
 	}
 	return tolower(*a) - tolower(*b);
 }
+#ifdef USE_ZIP
+//=============================================================================
+//	ZipDir
+//-----------------------------------------------------------------------------
+// browsable zip archive (with more than one supported member) / path inside of it
+static const xPlatform::eZipDir* ZipDir(const char* path)
+{
+	int l = strlen(path);
+	if(l < 5 || (StrCaseCmp(path + l - 5, ".zip/") && StrCaseCmp(path + l - 4, ".zip")))
+		return NULL;
+	char archive[xIo::MAX_PATH_LEN];
+	strcpy(archive, path);
+	if(archive[l - 1] == '/')
+		archive[l - 1] = '\0';
+	const xPlatform::eZipDir* d = xPlatform::eZipDir::Open(archive);
+	if(!d)
+		return NULL;
+	int supported = 0;
+	for(int i = 0; i < d->Members(); ++i)
+	{
+		if(xPlatform::Handler()->FileTypeSupported(d->Name(i)))
+			++supported;
+	}
+	return supported > 1 ? d : NULL;
+}
+#endif//USE_ZIP
 static int NameCmp(const void* _a, const void* _b)
 {
 	return StrCaseCmp(*(const char**)_a, *(const char**)_b);
 }
 //=============================================================================
+//	EntryCmp
+//-----------------------------------------------------------------------------
+static bool EntryCmp(const eDirEntry& a, const eDirEntry& b)
+{
+	if(a.dir != b.dir)
+		return a.dir; // folders first
+	return StrCaseCmp(a.name.c_str(), b.name.c_str()) < 0;
+}
+//=============================================================================
 //	eFileOpenDialog::OnChangePath
 //-----------------------------------------------------------------------------
 void eFileOpenDialog::OnChangePath()
 {
+	SAFE_DELETE(scan);
+	entries.clear();
 	list->Clear();
-	memset(folders, 0, sizeof(folders));
 
-	int i = 0;
 	if(!xIo::PathIsRoot(path))
 	{
 		list->Insert("..");
-		folders[i++] = true;
 	}
-	// put folder first
-	for(xIo::eFileSelect ds(path); i < MAX_ITEMS && ds.Valid(); ds.Next())
+#ifdef USE_ZIP
+	const xPlatform::eZipDir* zip = ZipDir(path);
+	if(zip)
 	{
-		if(!ds.IsDir())
-			continue;
-		if(!strcmp(ds.Name(), ".") || !strcmp(ds.Name(), ".."))
-			continue;
-		list->Insert(ds.Name());
-		folders[i++] = true;
+		for(int m = 0; m < zip->Members(); ++m)
+		{
+			if(!xPlatform::Handler()->FileTypeSupported(zip->Name(m)))
+				continue;
+			list->Insert(zip->Name(m));
+		}
+		qsort(list->Items() + 1, list->Size() - 1, sizeof(const char*), NameCmp);
+		return;
 	}
-	int folder_count = list->Size();
-	qsort(list->Items(), folder_count, sizeof(const char*), NameCmp);
-	for(xIo::eFileSelect fs(path); i < MAX_ITEMS && fs.Valid(); fs.Next())
+#endif//USE_ZIP
+	scan = new eDirScan(path);
+	OnScan();
+}
+//=============================================================================
+//	eFileOpenDialog::OnScan
+//-----------------------------------------------------------------------------
+// merges entries found by background scan into sorted list, only new ones are inserted
+void eFileOpenDialog::OnScan()
+{
+	std::vector<eDirEntry> found;
+	scan->Fetch(&found);
+	if(scan->Done())
+		SAFE_DELETE(scan);
+	size_t count = entries.size();
+	for(size_t e = 0; e < found.size(); ++e)
 	{
-		if(!fs.IsFile() || !xPlatform::Handler()->FileTypeSupported(fs.Name()))
+		if(found[e].dir || xPlatform::Handler()->FileTypeSupported(found[e].name.c_str()))
+			entries.push_back(found[e]);
+	}
+	if(entries.size() == count)
+		return;
+	std::sort(entries.begin() + count, entries.end(), EntryCmp);
+	std::vector<eDirEntry> added(entries.begin() + count, entries.end());
+	std::inplace_merge(entries.begin(), entries.begin() + count, entries.end(), EntryCmp);
+
+	int up = xIo::PathIsRoot(path) ? 0 : 1;
+	std::vector<eDirEntry>::const_iterator a = added.begin();
+	for(size_t e = 0; a != added.end() && e < entries.size(); ++e)
+	{
+		if(entries[e].dir != a->dir || entries[e].name != a->name)
 			continue;
-		list->Insert(fs.Name());
-		folders[i++] = false;
+		list->Insert(a->name.c_str(), e + up);
+		++a;
 	}
-	qsort(list->Items() + folder_count, list->Size() - folder_count, sizeof(const char*), NameCmp);
+	if(select_item.empty())
+		return;
+	const char* item = list->Item();
+	if(item && strcmp(item, "..")) // user already moved
+		return;
+	list->Item(select_item.c_str());
+	if(list->Item() && select_item == list->Item())
+		select_item.clear();
+}
+//=============================================================================
+//	eFileOpenDialog::Folder
+//-----------------------------------------------------------------------------
+bool eFileOpenDialog::Folder(int item) const
+{
+	if(!xIo::PathIsRoot(path) && item-- == 0) // ".."
+		return true;
+	return item >= 0 && item < (int)entries.size() && entries[item].dir;
+}
+//=============================================================================
+//	eFileOpenDialog::Update
+//-----------------------------------------------------------------------------
+void eFileOpenDialog::Update()
+{
+	if(scan)
+		OnScan();
+	eInherited::Update();
 }
 //=============================================================================
 //	GetUpLevel
@@ -144,7 +240,7 @@ void eFileOpenDialog::OnNotify(byte n, byte from)
 {
 	if(!list->Item())
 		return;
-	if(folders[list->Selected()])
+	if(Folder(list->Selected()))
 	{
 		const char* item = NULL;
 		if(!strcmp(list->Item(), ".."))
@@ -156,12 +252,19 @@ void eFileOpenDialog::OnNotify(byte n, byte from)
 			strcat(path, list->Item());
 			strcat(path, "/");
 		}
+		select_item = item ? item : "";
 		OnChangePath();
-		if(item)
-			list->Item(item);
 		return;
 	}
 	strcat(path, list->Item());
+#ifdef USE_ZIP
+	if(ZipDir(path)) // enter archive with several images like folder
+	{
+		strcat(path, "/");
+		OnChangePath();
+		return;
+	}
+#endif//USE_ZIP
 	selected = path;
 	eInherited::OnNotify(n, id);
 }
@@ -21,6 +21,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "../../ui/ui_dialog.h"
 #include "../io.h"
+#include "ui_dir_scan.h"
 
 #pragma once
 
@@ -33,20 +34,25 @@ class eList;
 
 class eFileOpenDialog : public eDialog
 {
-	enum { MAX_ITEMS = 2000 };
 	typedef eDialog eInherited;
 public:
 	eFileOpenDialog(const char* path);
+	virtual ~eFileOpenDialog();
 	virtual void Init();
+	virtual void Update();
 	const char* Selected() { return selected; }
 protected:
 	void OnNotify(byte n, byte from);
 	void OnChangePath();
+	void OnScan();
+	bool Folder(int item) const;
 protected:
 	char path[xIo::MAX_PATH_LEN];
 	eList* list;
-	bool folders[MAX_ITEMS];
 	const char* selected;
+	eDirScan* scan;
+	std::vector<eDirEntry> entries;
+	std::string select_item;
 };
 
 }
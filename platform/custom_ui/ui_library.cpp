@@ -0,0 +1,786 @@
+/*
+Portable ZX-Spectrum emulator.
+Copyright (C) 2001-2012 SMT, Dexus, Alone Coder, deathsoft, djdron, scor
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../../std.h"
+#include "../platform.h"
+#include "ui_library.h"
+#include "../../ui/ui_list.h"
+#include "../../tools/io_select.h"
+#include "../../tools/options.h"
+#include "../../tools/file_writer.h"
+#include "../../tools/job_thread.h"
+#include "../../file_type.h"
+#include "../../file_type_zip.h"
+#include "../../options_common.h"
+#include "../endian.h"
+#include <ctype.h>
+#include <algorithm>
+
+#if defined(_LINUX) || defined(_POSIX)
+#include <sys/stat.h>
+#endif//_LINUX || _POSIX
+
+#ifdef USE_UI
+
+namespace xUi
+{
+
+static struct eOptionLibraryFolders : public xOptions::eOptionString
+{
+	eOptionLibraryFolders() { customizable = false; }
+	virtual const char* Name() const { return "library folders"; }
+} op_library_folders; // separated by ';', folder of last opened file if empty
+
+static const char* INDEX_FILE = "library.idx";
+static const dword INDEX_VERSION = 1;
+enum { MAX_DEPTH = 8, SCREEN_SIZE = 6912 };
+
+//=============================================================================
+//	PathTime
+//-----------------------------------------------------------------------------
+// 0 if unknown, such files & folders are always rescanned
+static dword PathTime(const char* path)
+{
+#if defined(_LINUX) || defined(_POSIX)
+	struct stat st;
+	if(stat(path, &st) == 0)
+		return st.st_mtime;
+#endif//_LINUX || _POSIX
+	return 0;
+}
+//=============================================================================
+//	Hash
+//-----------------------------------------------------------------------------
+static dword Hash(const byte* data, size_t size)
+{
+	dword h = 2166136261u; // FNV-1a
+	for(size_t i = 0; i < size; ++i)
+	{
+		h ^= data[i];
+		h *= 16777619u;
+	}
+	return h;
+}
+//=============================================================================
+//	FindScreen
+//-----------------------------------------------------------------------------
+// screen$ stored in image, found without running it
+static const byte* FindScreen(const char* type, const byte* data, size_t size)
+{
+	if(!strcmp(type, "sna"))
+	{
+		return size >= 27 + SCREEN_SIZE ? data + 27 : NULL;
+	}
+	if(!strcmp(type, "tap"))
+	{
+		for(size_t pos = 0; pos + 2 <= size; )
+		{
+			size_t len = Word(data + pos);
+			if(len == SCREEN_SIZE + 2 && pos + 2 + len <= size && data[pos + 2] == 0xff)
+				return data + pos + 3;
+			pos += 2 + len;
+		}
+		return NULL;
+	}
+	if(!strcmp(type, "tzx"))
+	{
+		// standard speed data blocks only, can't skip others without parsing them
+		for(size_t pos = 10; pos + 5 <= size && data[pos] == 0x10; )
+		{
+			size_t len = Word(data + pos + 3);
+			if(len == SCREEN_SIZE + 2 && pos + 5 + len <= size && data[pos + 5] == 0xff)
+				return data + pos + 6;
+			pos += 5 + len;
+		}
+		return NULL;
+	}
+	return NULL;
+}
+//=============================================================================
+//	MakeThumb
+//-----------------------------------------------------------------------------
+// 4x4 pixels of screen$ to one, lit if colors are bright enough on average.
+// (ZX color index grows with its luminance: green > red > blue)
+static void MakeThumb(const byte* scr, std::vector<byte>* thumb)
+{
+	thumb->assign(eGameLibrary::THUMB_SIZE, 0);
+	for(int ty = 0; ty < eGameLibrary::THUMB_H; ++ty)
+	{
+		for(int tx = 0; tx < eGameLibrary::THUMB_W; ++tx)
+		{
+			int sum = 0;
+			for(int y = ty*4; y < ty*4 + 4; ++y)
+			{
+				int line = ((y & 0xc0) << 5) | ((y & 7) << 8) | ((y & 0x38) << 2);
+				byte attr = scr[6144 + (y >> 3)*32 + (tx >> 1)];
+				byte pixels = scr[line + (tx >> 1)];
+				for(int x = (tx & 1)*4; x < (tx & 1)*4 + 4; ++x)
+				{
+					bool ink = (pixels << x) & 0x80;
+					sum += ink ? attr & 7 : (attr >> 3) & 7;
+				}
+			}
+			if(sum*2 >= 7*16)
+				(*thumb)[ty*eGameLibrary::THUMB_W/8 + tx/8] |= 0x80 >> (tx & 7);
+		}
+	}
+}
+//=============================================================================
+//	ZxkTitle
+//-----------------------------------------------------------------------------
+// gameConfig applies pokes while parsing, so only title line is taken here
+static std::string ZxkTitle(const byte* data, size_t size)
+{
+	const char* s = (const char*)data;
+	const char* end = s + size;
+	while(s < end)
+	{
+		const char* e = s;
+		while(e < end && *e != '\n' && *e != '\r')
+			++e;
+		if(e - s > 2 && s[0] == 'T' && s[1] == ':')
+			return std::string(s + 2, e);
+		s = e + 1;
+	}
+	return std::string();
+}
+
+//=============================================================================
+//	eGameLibrary::AddGame
+//-----------------------------------------------------------------------------
+void eGameLibrary::AddGame(const std::string& path, xIo::eFileData* file, dword time, int folder)
+{
+	xPlatform::eFileType* t = xPlatform::eFileType::FindByName(path.c_str());
+	if(!t)
+		return;
+	eGame g;
+	g.path = path;
+	g.type = t->Type();
+	g.size = file->Size();
+	g.hash = Hash(file->Data(), file->Size());
+	g.time = time;
+	g.folder = folder;
+	if(g.type == "zxk")
+		g.title = ZxkTitle(file->Data(), file->Size());
+	if(g.title.empty())
+	{
+		std::string::size_type b = path.find_last_of("/\\");
+		b = b == std::string::npos ? 0 : b + 1;
+		std::string::size_type e = path.find_last_of('.');
+		g.title = path.substr(b, e != std::string::npos && e > b ? e - b : std::string::npos);
+	}
+	const byte* scr = FindScreen(g.type.c_str(), file->Data(), file->Size());
+	if(scr)
+		MakeThumb(scr, &g.thumb);
+	games.push_back(g);
+}
+//=============================================================================
+//	eGameLibrary::AddFile
+//-----------------------------------------------------------------------------
+void eGameLibrary::AddFile(const std::string& name, dword time, int folder)
+{
+	++rescanned;
+	xIo::eFileData* file = xIo::eFileData::Open(name.c_str());
+	if(!file)
+		return;
+#ifdef USE_ZIP
+	xPlatform::eFileType* t = xPlatform::eFileType::FindByName(name.c_str());
+	if(!strcmp(t->Type(), "zip"))
+	{
+		// zip cache is for main thread only
+		xPlatform::eZipDir* d = xPlatform::eZipDir::OpenUncached(name.c_str(), file);
+		for(int m = 0; d && m < d->Members(); ++m)
+		{
+			xPlatform::eFileType* mt = xPlatform::eFileType::FindByName(d->Name(m));
+			if(!mt || mt == t)
+				continue;
+			xIo::eFileData* f = d->Inflate(m, file);
+			if(!f)
+				continue;
+			AddGame(name + "/" + d->Name(m), f, time, folder);
+			f->Release();
+		}
+		delete d;
+		file->Release();
+		return;
+	}
+#endif//USE_ZIP
+	AddGame(name, file, time, folder);
+	file->Release();
+}
+//=============================================================================
+//	eGameLibrary::Visit
+//-----------------------------------------------------------------------------
+void eGameLibrary::Visit(const std::string& path, const eOld& old, int depth)
+{
+	int f = folders.size();
+	folders.push_back(eFolder());
+	folders[f].path = path;
+	folders[f].time = PathTime(path.c_str());
+	std::map<std::string, int>::const_iterator of = old.folder_by_path.find(path);
+	if(folders[f].time && of != old.folder_by_path.end() && old.folders[of->second].time == folders[f].time)
+	{
+		// nothing added/removed here, take listing from index
+		folders[f].subdirs = old.folders[of->second].subdirs;
+		const std::vector<int>& og = old.games_by_folder[of->second];
+		for(size_t i = 0; i < og.size(); ++i)
+		{
+			games.push_back(old.games[og[i]]);
+			games.back().folder = f;
+		}
+	}
+	else
+	{
+		for(xIo::eFileSelect fs(path.c_str()); fs.Valid(); fs.Next())
+		{
+			if(fs.IsDir())
+			{
+				if(strcmp(fs.Name(), ".") && strcmp(fs.Name(), ".."))
+					folders[f].subdirs.push_back(fs.Name());
+				continue;
+			}
+			if(!fs.IsFile() || !xPlatform::eFileType::FindByName(fs.Name()))
+				continue;
+			std::string name = path + fs.Name();
+			dword time = PathTime(name.c_str());
+			std::map<std::string, std::vector<int> >::const_iterator og = old.games_by_file.find(name);
+			bool same = time && og != old.games_by_file.end();
+			for(size_t i = 0; same && i < og->second.size(); ++i)
+			{
+				same = old.games[og->second[i]].time == time;
+			}
+			if(!same)
+			{
+				AddFile(name, time, f);
+				continue;
+			}
+			for(size_t i = 0; i < og->second.size(); ++i)
+			{
+				games.push_back(old.games[og->second[i]]);
+				games.back().folder = f;
+			}
+		}
+	}
+	if(depth >= MAX_DEPTH)
+		return;
+	std::vector<std::string> subdirs = folders[f].subdirs;
+	for(size_t i = 0; i < subdirs.size(); ++i)
+	{
+		Visit(path + subdirs[i] + "/", old, depth + 1);
+	}
+}
+//=============================================================================
+//	eGameLibrary::Update
+//-----------------------------------------------------------------------------
+// roots separated by ';', runs in any thread
+bool eGameLibrary::Update(const std::string& roots)
+{
+	eOld old;
+	old.folders.swap(folders);
+	old.games.swap(games);
+	old.games_by_folder.resize(old.folders.size());
+	for(size_t i = 0; i < old.folders.size(); ++i)
+	{
+		old.folder_by_path[old.folders[i].path] = i;
+	}
+	for(size_t i = 0; i < old.games.size(); ++i)
+	{
+		const eGame& g = old.games[i];
+		old.games_by_folder[g.folder].push_back(i);
+		std::string file = g.path;
+#ifdef USE_ZIP
+		char archive[xIo::MAX_PATH_LEN];
+		const char* member;
+		if(xPlatform::eZipDir::SplitPath(g.path.c_str(), archive, &member))
+			file = archive;
+#endif//USE_ZIP
+		old.games_by_file[file].push_back(i);
+	}
+	rescanned = 0;
+	for(std::string::size_type b = 0; b < roots.size(); )
+	{
+		std::string::size_type e = roots.find(';', b);
+		if(e == std::string::npos)
+			e = roots.size();
+		std::string root = roots.substr(b, e - b);
+		b = e + 1;
+		if(root.empty())
+			continue;
+		if(root[root.size() - 1] != '/' && root[root.size() - 1] != '\\')
+			root += '/';
+		Visit(root, old, 0);
+	}
+	return rescanned || folders.size() != old.folders.size() || games.size() != old.games.size();
+}
+
+//*****************************************************************************
+//	eLibraryUpdate
+//-----------------------------------------------------------------------------
+// rescans copy of library in background thread
+//-----------------------------------------------------------------------------
+struct eLibraryUpdate : public eJobThread::eJob
+{
+	eLibraryUpdate() : lib(NULL), changed(false) {}
+	virtual void Execute() { changed = lib->Update(roots); }
+	eJobThread thread;
+	eGameLibrary* lib; // in progress if not NULL
+	std::string roots;
+	bool changed;
+};
+static eLibraryUpdate* library_update = NULL;
+
+//=============================================================================
+//	eGameLibrary::UpdateStart
+//-----------------------------------------------------------------------------
+void eGameLibrary::UpdateStart()
+{
+	if(!library_update)
+		library_update = new eLibraryUpdate;
+	if(library_update->lib)
+		return;
+	const char* folders_value = op_library_folders;
+	library_update->roots = folders_value ? folders_value : "";
+	if(library_update->roots.empty())
+		library_update->roots = xPlatform::OpLastFolder();
+	library_update->lib = new eGameLibrary(*this);
+	library_update->thread.Start(library_update);
+}
+//=============================================================================
+//	eGameLibrary::Updated
+//-----------------------------------------------------------------------------
+bool eGameLibrary::Updated()
+{
+	if(!library_update || !library_update->lib || library_update->thread.Busy())
+		return false;
+	bool changed = library_update->changed;
+	if(changed)
+	{
+		folders.swap(library_update->lib->folders);
+		games.swap(library_update->lib->games);
+		Save();
+	}
+	SAFE_DELETE(library_update->lib);
+	return changed;
+}
+//=============================================================================
+//	eGameLibrary::Find
+//-----------------------------------------------------------------------------
+void eGameLibrary::Find(const char* text, std::vector<int>* found) const
+{
+	std::string t = text;
+	std::transform(t.begin(), t.end(), t.begin(), tolower);
+	for(int i = 0; i < Games(); ++i)
+	{
+		std::string title = games[i].title;
+		std::transform(title.begin(), title.end(), title.begin(), tolower);
+		if(title.find(t) != std::string::npos)
+			found->push_back(i);
+	}
+}
+
+//*****************************************************************************
+//	index file: "USPL", version, folders, games. little endian dwords,
+//	strings prefixed by dword length
+//-----------------------------------------------------------------------------
+struct eIndexWriter
+{
+	void Dword(dword v) { for(int i = 0; i < 4; ++i) data.push_back(v >> (i*8)); }
+	void Bytes(const byte* p, size_t size) { data.insert(data.end(), p, p + size); }
+	void String(const std::string& s) { Dword(s.size()); Bytes((const byte*)s.data(), s.size()); }
+	std::vector<byte> data;
+};
+struct eIndexReader
+{
+	eIndexReader(const byte* _p, size_t size) : p(_p), end(_p + size), ok(true) {}
+	bool Need(size_t size) { ok = ok && size_t(end - p) >= size; return ok; }
+	dword Dword()
+	{
+		if(!Need(4))
+			return 0;
+		dword v = p[0] | (p[1] << 8) | (p[2] << 16) | (p[3] << 24);
+		p += 4;
+		return v;
+	}
+	void Bytes(std::vector<byte>* v, size_t size)
+	{
+		if(!Need(size))
+			return;
+		v->assign(p, p + size);
+		p += size;
+	}
+	std::string String()
+	{
+		size_t size = Dword();
+		if(!Need(size))
+			return std::string();
+		std::string s((const char*)p, size);
+		p += size;
+		return s;
+	}
+	const byte* p;
+	const byte* end;
+	bool ok;
+};
+
+//=============================================================================
+//	eGameLibrary::Load
+//-----------------------------------------------------------------------------
+bool eGameLibrary::Load()
+{
+	folders.clear();
+	games.clear();
+	xIo::eFileData* file = xIo::eFileData::Open(xIo::ProfilePath(INDEX_FILE));
+	if(!file)
+		return false;
+	eIndexReader r(file->Data(), file->Size());
+	bool ok = r.Need(4) && !memcmp(r.p, "USPL", 4);
+	if(ok)
+		r.p += 4;
+	ok = ok && r.Dword() == INDEX_VERSION;
+	dword count = ok ? r.Dword() : 0;
+	for(dword i = 0; r.ok && i < count; ++i)
+	{
+		eFolder f;
+		f.path = r.String();
+		f.time = r.Dword();
+		dword subdirs = r.Dword();
+		for(dword s = 0; r.ok && s < subdirs; ++s)
+		{
+			f.subdirs.push_back(r.String());
+		}
+		folders.push_back(f);
+	}
+	count = ok ? r.Dword() : 0;
+	for(dword i = 0; r.ok && i < count; ++i)
+	{
+		eGame g;
+		g.path = r.String();
+		g.title = r.String();
+		g.type = r.String();
+		g.size = r.Dword();
+		g.hash = r.Dword();
+		g.time = r.Dword();
+		g.folder = r.Dword();
+		if(r.Dword())
+			r.Bytes(&g.thumb, THUMB_SIZE);
+		if(g.folder >= (int)folders.size())
+			r.ok = false;
+		games.push_back(g);
+	}
+	file->Release();
+	if(ok && r.ok)
+		return true;
+	folders.clear();
+	games.clear();
+	return false;
+}
+//=============================================================================
+//	eGameLibrary::Save
+//-----------------------------------------------------------------------------
+bool eGameLibrary::Save() const
+{
+	eIndexWriter w;
+	w.Bytes((const byte*)"USPL", 4);
+	w.Dword(INDEX_VERSION);
+	w.Dword(folders.size());
+	for(size_t i = 0; i < folders.size(); ++i)
+	{
+		const eFolder& f = folders[i];
+		w.String(f.path);
+		w.Dword(f.time);
+		w.Dword(f.subdirs.size());
+		for(size_t s = 0; s < f.subdirs.size(); ++s)
+		{
+			w.String(f.subdirs[s]);
+		}
+	}
+	w.Dword(games.size());
+	for(size_t i = 0; i < games.size(); ++i)
+	{
+		const eGame& g = games[i];
+		w.String(g.path);
+		w.String(g.title);
+		w.String(g.type);
+		w.Dword(g.size);
+		w.Dword(g.hash);
+		w.Dword(g.time);
+		w.Dword(g.folder);
+		w.Dword(!g.thumb.empty());
+		if(!g.thumb.empty())
+			w.Bytes(&g.thumb[0], g.thumb.size());
+	}
+	xIo::eFileWrite fw(xIo::ProfilePath(INDEX_FILE), false);
+	fw.Add(0, &w.data[0], w.data.size());
+	return fw.Execute();
+}
+
+eGameLibrary* GameLibrary()
+{
+	static eGameLibrary* library = NULL;
+	if(!library)
+	{
+		library = new eGameLibrary;
+		library->Load();
+	}
+	return library;
+}
+
+//*****************************************************************************
+//	eThumb
+//-----------------------------------------------------------------------------
+class eThumb : public eControl
+{
+public:
+	eThumb() : thumb(NULL) { changed = true; }
+	void Image(const std::vector<byte>* v) { thumb = v; changed = true; }
+	virtual void Update()
+	{
+		if(!changed)
+			return;
+		changed = false;
+		eRect sr = ScreenBound();
+		DrawRect(sr, background);
+		if(!thumb || thumb->empty())
+			return;
+		int scale = sr.Width()/eGameLibrary::THUMB_W;
+		for(int y = 0; y < eGameLibrary::THUMB_H; ++y)
+		{
+			for(int x = 0; x < eGameLibrary::THUMB_W; ++x)
+			{
+				if(!((*thumb)[y*eGameLibrary::THUMB_W/8 + x/8] & (0x80 >> (x & 7))))
+					continue;
+				eRect p(sr.left + x*scale, sr.top + y*scale, sr.left + (x + 1)*scale, sr.top + (y + 1)*scale);
+				DrawRect(p, COLOR_WHITE);
+			}
+		}
+	}
+	virtual bool OnKey(char key, dword flags) { return false; }
+protected:
+	const std::vector<byte>* thumb;
+};
+
+//*****************************************************************************
+//	eSearch
+//-----------------------------------------------------------------------------
+// title search text entered by joystick: up/down changes last letter,
+// right adds next one, left removes it
+//-----------------------------------------------------------------------------
+class eSearch : public eControl
+{
+	typedef eControl eInherited;
+	enum { MAX_TEXT_SIZE = 24 };
+public:
+	enum eNotify { N_CHANGED, N_DONE };
+	eSearch() { *text = '\0'; }
+	const char* Text() const { return text; }
+	virtual void Update()
+	{
+		bool change_focus = focused != last_focused;
+		eInherited::Update();
+		if(!changed && !change_focus)
+			return;
+		changed = false;
+		eRect sr = ScreenBound();
+		DrawRect(sr, focused ? COLOR_FOCUSED : background);
+		char s[MAX_TEXT_SIZE + 8];
+		sprintf(s, "find:%s%s", text, focused ? "_" : "");
+		DrawText(sr, s);
+	}
+	virtual bool OnKey(char key, dword flags)
+	{
+		static const char letters[] = " ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+		int l = strlen(text);
+		switch(key)
+		{
+		case 'u':
+		case 'd':
+			if(!l)
+				text[l++] = ' ';
+			{
+				const char* c = strchr(letters, text[l - 1]);
+				int i = c ? c - letters : 0;
+				int count = sizeof(letters) - 1;
+				i = key == 'd' ? (i + 1) % count : (i + count - 1) % count;
+				text[l - 1] = letters[i];
+				text[l] = '\0';
+			}
+			break;
+		case 'r':
+			if(!l || l == MAX_TEXT_SIZE)
+				return true;
+			text[l] = 'A';
+			text[l + 1] = '\0';
+			break;
+		case 'l':
+			if(!l)
+				return true;
+			text[l - 1] = '\0';
+			break;
+		case 'e':
+		case 'f':
+		case ' ':
+			Notify(N_DONE);
+			return true;
+		default:
+			return false;
+		}
+		changed = true;
+		Notify(N_CHANGED);
+		return true;
+	}
+protected:
+	char text[MAX_TEXT_SIZE + 1];
+};
+
+//=============================================================================
+//	TitleCmp
+//-----------------------------------------------------------------------------
+struct eTitleCmp
+{
+	bool operator()(int a, int b) const
+	{
+		const std::string& ta = GameLibrary()->Game(a).title;
+		const std::string& tb = GameLibrary()->Game(b).title;
+		for(size_t i = 0; i < ta.size() && i < tb.size(); ++i)
+		{
+			int d = tolower(ta[i]) - tolower(tb[i]);
+			if(d)
+				return d < 0;
+		}
+		return ta.size() < tb.size();
+	}
+};
+//=============================================================================
+//	eLibraryDialog::Init
+//-----------------------------------------------------------------------------
+void eLibraryDialog::Init()
+{
+	background = COLOR_BACKGROUND;
+	eRect r(8, 8, 312, 180);
+	ePoint margin(6, 6);
+	Bound() = r;
+	list = new eList;
+	list->Id(C_LIST);
+	list->Bound() = eRect(margin.x, margin.y, 160, r.Height() - margin.y);
+	Insert(list);
+	thumb = new eThumb;
+	thumb->Bound() = eRect(166, margin.y, 166 + eGameLibrary::THUMB_W*2, margin.y + eGameLibrary::THUMB_H*2);
+	Insert(thumb);
+	search = new eSearch;
+	search->Id(C_SEARCH);
+	int y = thumb->Bound().bottom + margin.y;
+	search->Bound() = eRect(166, y, r.Width() - margin.x, y + FontSize().y);
+	Insert(search);
+
+	// index as it was saved is shown until update in background finishes
+	GameLibrary()->UpdateStart();
+	Fill();
+}
+//=============================================================================
+//	eLibraryDialog::Fill
+//-----------------------------------------------------------------------------
+void eLibraryDialog::Fill()
+{
+	eGameLibrary* lib = GameLibrary();
+	order.clear();
+	if(*search->Text())
+		lib->Find(search->Text(), &order);
+	else
+	{
+		for(int i = 0; i < lib->Games(); ++i)
+		{
+			order.push_back(i);
+		}
+	}
+	std::sort(order.begin(), order.end(), eTitleCmp());
+	list->Clear();
+	for(size_t i = 0; i < order.size(); ++i)
+	{
+		list->Insert(lib->Game(order[i]).title.c_str());
+	}
+	for(size_t i = 0; i < order.size(); ++i)
+	{
+		if(lib->Game(order[i]).path == current)
+		{
+			list->Selected(i);
+			break;
+		}
+	}
+	last_selected = -1;
+}
+//=============================================================================
+//	eLibraryDialog::Focus
+//-----------------------------------------------------------------------------
+void eLibraryDialog::Focus(eControl* c)
+{
+	SAFE_CALL(focused)->Focused(false);
+	focused = c;
+	focused->Focused(true);
+}
+//=============================================================================
+//	eLibraryDialog::Update
+//-----------------------------------------------------------------------------
+void eLibraryDialog::Update()
+{
+	if(GameLibrary()->Updated())
+		Fill();
+	if(list->Selected() != last_selected)
+	{
+		last_selected = list->Selected();
+		const eGameLibrary::eGame* g = last_selected >= 0 ? &GameLibrary()->Game(order[last_selected]) : NULL;
+		if(g)
+			current = g->path;
+		thumb->Image(g ? &g->thumb : NULL);
+	}
+	eInherited::Update();
+}
+//=============================================================================
+//	eLibraryDialog::OnKey
+//-----------------------------------------------------------------------------
+bool eLibraryDialog::OnKey(char key, dword flags)
+{
+	if(key == '1' && focused) // switch between list & search
+	{
+		Focus(focused == list ? (eControl*)search : (eControl*)list);
+		return true;
+	}
+	return eInherited::OnKey(key, flags);
+}
+//=============================================================================
+//	eLibraryDialog::OnNotify
+//-----------------------------------------------------------------------------
+void eLibraryDialog::OnNotify(byte n, byte from)
+{
+	if(from == C_SEARCH)
+	{
+		if(n == eSearch::N_CHANGED)
+			Fill();
+		else
+			Focus(list);
+		return;
+	}
+	if(list->Selected() < 0)
+		return;
+	selected = GameLibrary()->Game(order[list->Selected()]).path.c_str();
+	eInherited::OnNotify(n, id);
+}
+
+}
+//namespace xUi
+
+#endif//USE_UI
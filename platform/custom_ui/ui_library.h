@@ -0,0 +1,131 @@
+/*
+Portable ZX-Spectrum emulator.
+Copyright (C) 2001-2012 SMT, Dexus, Alone Coder, deathsoft, djdron, scor
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef	__UI_LIBRARY_H__
+#define	__UI_LIBRARY_H__
+
+#include <string>
+#include <vector>
+#include <map>
+#include "../../ui/ui_dialog.h"
+#include "../io.h"
+
+#pragma once
+
+#ifdef USE_UI
+
+namespace xUi
+{
+
+//*****************************************************************************
+//	eGameLibrary
+//-----------------------------------------------------------------------------
+// index of games found in library folders (zip members included), kept in
+// binary file in profile folder. on update only folders with changed
+// modification time are listed again, and only changed files are read.
+// update runs in background thread, index stays usable meanwhile
+//-----------------------------------------------------------------------------
+class eGameLibrary
+{
+public:
+	enum { THUMB_W = 64, THUMB_H = 48, THUMB_SIZE = THUMB_W*THUMB_H/8 };
+	struct eGame
+	{
+		std::string path;	// "folder/archive.zip/member" for zip members
+		std::string title;
+		std::string type;
+		dword	size;
+		dword	hash;
+		dword	time;		// modification time of file (archive) game found in
+		int		folder;
+		std::vector<byte> thumb; // THUMB_W x THUMB_H, 1 bit per pixel, empty if unknown
+	};
+
+	bool Load();
+	bool Save() const;
+	bool Update(const std::string& roots); // true if anything was rescanned
+	void UpdateStart(); // of library folders in background
+	bool Updated(); // true (once) if background update finished with changes, they are saved
+
+	int Games() const { return games.size(); }
+	const eGame& Game(int i) const { return games[i]; }
+	void Find(const char* text, std::vector<int>* found) const; // by title, case insensitive
+
+protected:
+	struct eFolder
+	{
+		std::string path;
+		dword	time;
+		std::vector<std::string> subdirs;
+	};
+	struct eOld
+	{
+		std::vector<eFolder> folders;
+		std::vector<eGame> games;
+		std::map<std::string, int> folder_by_path;
+		std::map<std::string, std::vector<int> > games_by_file;
+		std::vector<std::vector<int> > games_by_folder;
+	};
+	void Visit(const std::string& path, const eOld& old, int depth);
+	void AddFile(const std::string& name, dword time, int folder);
+	void AddGame(const std::string& path, xIo::eFileData* file, dword time, int folder);
+
+	std::vector<eFolder> folders;
+	std::vector<eGame> games;
+	int rescanned;
+};
+
+eGameLibrary* GameLibrary();
+
+class eList;
+class eThumb;
+class eSearch;
+
+//*****************************************************************************
+//	eLibraryDialog
+//-----------------------------------------------------------------------------
+class eLibraryDialog : public eDialog
+{
+	typedef eDialog eInherited;
+public:
+	eLibraryDialog() : list(NULL), thumb(NULL), search(NULL), selected(NULL), last_selected(-1) {}
+	virtual void Init();
+	virtual void Update();
+	virtual bool OnKey(char key, dword flags);
+	const char* Selected() { return selected; }
+protected:
+	void OnNotify(byte n, byte from);
+	void Fill(); // list with games found by search
+	void Focus(eControl* c);
+protected:
+	enum { C_LIST, C_SEARCH };
+	eList* list;
+	eThumb* thumb;
+	eSearch* search;
+	std::vector<int> order; // games listed, sorted by title
+	std::string current; // path of selected game
+	const char* selected;
+	int last_selected;
+};
+
+}
+//namespace xUi
+
+#endif//USE_UI
+
+#endif//__UI_LIBRARY_H__
@@ -22,6 +22,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "ui_menu.h"
 #include "ui_keyboard.h"
 #include "ui_file_open.h"
+#include "ui_library.h"
 #include "../../tools/options.h"
 #include "../../tools/profiler.h"
 #include "../../options_common.h"
@@ -44,6 +45,15 @@ static struct eOptionOpenFile : public xOptions::eOptionB
 	bool on;
 } op_open_file;
 
+static struct eOptionGameLibrary : public xOptions::eOptionB
+{
+	eOptionGameLibrary() : on(false) { storeable = false; }
+	virtual const char* Name() const { return "game library"; }
+	virtual const char*	Value() const { return ">"; }
+	virtual void Change(bool next = true) { if(next) on = true; }
+	bool on;
+} op_game_library;
+
 //=============================================================================
 //	eMainDialog::eMainDialog
 //-----------------------------------------------------------------------------
@@ -69,6 +79,14 @@ void eMainDialog::Update()
 		d->Id(D_FILE_OPEN);
 		Insert(d);
 	}
+	if(op_game_library.on)
+	{
+		op_game_library.on = false;
+		Clear();
+		eDialog* d = new eLibraryDialog;
+		d->Id(D_LIBRARY);
+		Insert(d);
+	}
 }
 //=============================================================================
 //	eMainDialog::OnKey
@@ -127,6 +145,15 @@ void eMainDialog::OnNotify(byte n, byte from)
 			clear = true;
 		}
 		break;
+	case D_LIBRARY:
+		if(!clear)
+		{
+			eLibraryDialog* d = (eLibraryDialog*)*childs;
+			Handler()->OnOpenFile(d->Selected());
+			clear = true;
+		}
+		break;
+
 	case D_KEYS:
 		{
 			eKeyboard* d = (eKeyboard*)*childs;
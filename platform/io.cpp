@@ -19,6 +19,15 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "../std.h"
 #include "io.h"
 
+#if defined(_LINUX) || defined(_POSIX)
+#define USE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif//_LINUX || _POSIX
+
+
 namespace xIo
 {
 
@@ -58,6 +67,78 @@ const char* ProfilePath(const char* _path)
 	strcat(buf, _path);
 	return buf;
 }
+//=============================================================================
+//	eFileData::Open
+//-----------------------------------------------------------------------------
+eFileData* eFileData::Open(const char* name)
+{
+#ifdef USE_MMAP
+	int fd = open(name, O_RDONLY);
+	if(fd < 0)
+		return NULL;
+	struct stat st;
+	if(fstat(fd, &st) == 0 && st.st_size > 0)
+	{
+		void* m = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(m != MAP_FAILED)
+		{
+			close(fd);
+			eFileData* f = new eFileData;
+			f->data = (const byte*)m;
+			f->size = st.st_size;
+			f->mapped = true;
+			return f;
+		}
+	}
+	close(fd);
+#endif//USE_MMAP
+	FILE* h = fopen(name, "rb");
+	if(!h)
+		return NULL;
+	fseek(h, 0, SEEK_END);
+	size_t size = ftell(h);
+	fseek(h, 0, SEEK_SET);
+	eFileData* f = Create(size);
+	size_t r = fread(f->Buffer(), 1, size, h);
+	fclose(h);
+	if(r != size)
+	{
+		f->Release();
+		return NULL;
+	}
+	return f;
+}
+//=============================================================================
+//	eFileData::Create
+//-----------------------------------------------------------------------------
+eFileData* eFileData::Create(size_t size)
+{
+	eFileData* f = new eFileData;
+	f->buffer = new byte[size];
+	f->data = f->buffer;
+	f->size = size;
+	return f;
+}
+//=============================================================================
+//	eFileData::Copy
+//-----------------------------------------------------------------------------
+eFileData* eFileData::Copy(const void* data, size_t size)
+{
+	eFileData* f = Create(size);
+	memcpy(f->Buffer(), data, size);
+	return f;
+}
+//=============================================================================
+//	eFileData::~eFileData
+//-----------------------------------------------------------------------------
+eFileData::~eFileData()
+{
+#ifdef USE_MMAP
+	if(mapped)
+		munmap((void*)data, size);
+#endif//USE_MMAP
+	SAFE_DELETE_ARRAY(buffer);
+}
 
 }
 //namespace xIo
@@ -32,6 +32,38 @@ const char* ResourcePath(const char* path);
 void SetProfilePath(const char* profile_path);
 const char* ProfilePath(const char* path);
 
+//*****************************************************************************
+//	eFileData - read-only file contents, shared by reference counting
+//-----------------------------------------------------------------------------
+// file is mapped to memory where possible, so no copy of data made on open.
+// everyone who keeps pointers to Data() must hold a reference
+//-----------------------------------------------------------------------------
+class eFileData
+{
+public:
+	static eFileData* Open(const char* name);
+	static eFileData* Create(size_t size); // to be filled through Buffer()
+	static eFileData* Copy(const void* data, size_t size);
+
+	const byte* Data() const	{ return data; }
+	byte* Buffer()				{ return buffer; }
+	size_t Size() const			{ return size; }
+
+	eFileData* AddRef()			{ ++refs; return this; }
+	void Release()				{ if(!--refs) delete this; }
+
+private:
+	eFileData() : data(NULL), buffer(NULL), size(0), refs(1), mapped(false) {}
+	~eFileData();
+
+	const byte* data;
+	byte*	buffer;
+	size_t	size;
+	int		refs;
+	bool	mapped;
+};
+
+
 }
 //namespace xIo
 
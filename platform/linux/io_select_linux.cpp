@@ -32,33 +32,48 @@ namespace xIo
 class eFileSelectI
 {
 public:
-	eFileSelectI(const char* _path) : path(_path), dir_ent(NULL)
+	eFileSelectI(const char* path) : dir_ent(NULL), is_dir(false), is_file(false)
 	{
+		strcpy(full_name, path);
+		name = full_name + strlen(full_name);
 		dir = opendir(path);
 		if(dir)
 			Next();
 	}
-	~eFileSelectI() { closedir(dir); }
+	~eFileSelectI() { if(dir) closedir(dir); }
 	bool Valid() const { return dir && dir_ent; }
-	void Next() { dir_ent = readdir(dir); FillStat(); }
+	void Next() { dir_ent = readdir(dir); FillType(); }
 	const char* Name() const { return dir_ent->d_name; }
-	bool IsDir() const { return S_ISDIR(dir_stat.st_mode); }
-	bool IsFile() const { return S_ISREG(dir_stat.st_mode); }
+	bool IsDir() const { return is_dir; }
+	bool IsFile() const { return is_file; }
 
-	void FillStat()
+	void FillType()
 	{
 		if(!Valid())
 			return;
+#ifdef DT_UNKNOWN
+		// most file systems report entry type right away, no need to stat
+		if(dir_ent->d_type != DT_UNKNOWN && dir_ent->d_type != DT_LNK)
+		{
+			is_dir = dir_ent->d_type == DT_DIR;
+			is_file = dir_ent->d_type == DT_REG;
+			return;
+		}
+#endif//DT_UNKNOWN
+		struct stat dir_stat;
 		memset(&dir_stat, 0, sizeof(dir_stat));
-		char full_name[MAX_PATH_LEN];
-		strcpy(full_name, path);
-		strcat(full_name, dir_ent->d_name);
+		strncpy(name, dir_ent->d_name, full_name + MAX_PATH_LEN - name - 1);
+		full_name[MAX_PATH_LEN - 1] = '\0';
 		stat(full_name, &dir_stat);
+		is_dir = S_ISDIR(dir_stat.st_mode);
+		is_file = S_ISREG(dir_stat.st_mode);
 	}
-	const char* path;
 	DIR* dir;
 	dirent* dir_ent;
-	struct stat dir_stat;
+	char full_name[MAX_PATH_LEN];
+	char* name; // entry name part of full_name
+	bool is_dir;
+	bool is_file;
 };
 
 eFileSelect::eFileSelect(const char* path) { impl = new eFileSelectI(path); }
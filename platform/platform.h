@@ -119,6 +119,14 @@ struct eHandler
 
 	virtual bool FullSpeed() const = 0;
 
+	// .rzx replay: frame to be played next (-1 if no replay), seek to any frame
+	// (played already ones too), returns frame reached
+	virtual int ReplayFrame() const = 0;
+	virtual int OnReplaySeek(int frame) = 0;
+
+	// cpu execution trace into file (stopped if name is NULL)
+	virtual bool OnTrace(const char* name) = 0;
+
 	char m_keymap[END_PHYSICAL_KEY];
 };
 
@@ -168,6 +168,13 @@ static byte TranslateKey(SDLKey _key, dword& _flags)
 
 void ProcessKey(SDL_Event& e)
 {
+	if(e.key.keysym.sym == SDLK_F4 && !e.key.keysym.mod) // fast forward while held
+	{
+		using namespace xOptions;
+		eOption<bool>* o = eOption<bool>::Find("fast forward");
+		SAFE_CALL(o)->Set(e.type == SDL_KEYDOWN);
+		return;
+	}
 	switch(e.type)
 	{
 	case SDL_KEYDOWN:
@@ -0,0 +1,127 @@
+/*
+Portable ZX-Spectrum emulator.
+Copyright (C) 2001-2013 SMT, Dexus, Alone Coder, deathsoft, djdron, scor
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+// compares two cpu execution traces written by xZ80::eTrace (see OnTrace()),
+// reports the first record they diverge at with a few records before it
+
+#include "../../std.h"
+#include "../../z80/z80_trace.h"
+#include <zlib.h>
+
+using xZ80::eTrace;
+
+enum { CONTEXT = 8, RECORD_MAX = eTrace::STATE_SIZE };
+
+struct eTraceFile
+{
+	eTraceFile() : file(NULL), size(0), steps(0), ints(0) {}
+	~eTraceFile() { if(file) gzclose(file); }
+	bool Open(const char* name)
+	{
+		file = gzopen(name, "rb");
+		if(!file)
+			return false;
+		char sig[16];
+		int l = strlen(eTrace::Signature());
+		return gzread(file, sig, l) == l && !memcmp(sig, eTrace::Signature(), l);
+	}
+	// false at the end of trace, size is 0 if trace is damaged
+	bool Next()
+	{
+		size = 0;
+		int type = gzgetc(file);
+		if(type < 0)
+			return false;
+		rec[0] = type;
+		size = eTrace::RecordSize(type);
+		if(!size || gzread(file, rec + 1, size - 1) != int(size - 1))
+		{
+			size = 0;
+			return false;
+		}
+		if(type == eTrace::R_STEP)
+			++steps;
+		else if(type == eTrace::R_INT)
+			++ints;
+		return true;
+	}
+	gzFile file;
+	byte rec[RECORD_MAX];
+	size_t size;
+	qword steps;
+	qword ints;
+};
+
+static void Print(const char* prefix, const byte* r)
+{
+	if(r[0] == eTrace::R_STEP || r[0] == eTrace::R_INT)
+	{
+		printf("%s%c pc=%04X op=%02X %02X %02X %02X af=%04X bc=%04X de=%04X hl=%04X"
+			" af'=%04X bc'=%04X de'=%04X hl'=%04X ix=%04X iy=%04X sp=%04X ir=%04X mp=%04X"
+			" t=%d iff=%d%d halt=%d im=%d\n",
+			prefix, r[0], Word(r + 1), r[3], r[4], r[5], r[6], Word(r + 7), Word(r + 9), Word(r + 11), Word(r + 13),
+			Word(r + 15), Word(r + 17), Word(r + 19), Word(r + 21), Word(r + 23), Word(r + 25), Word(r + 27), Word(r + 29), Word(r + 31),
+			int(Dword(r + 33)), r[37]&1, (r[37] >> 1)&1, (r[37] >> 2)&1, r[37] >> 3);
+	}
+	else
+		printf("%s%c port=%04X v=%02X t=%d\n", prefix, r[0], Word(r + 1), r[3], int(Dword(r + 4)));
+}
+
+int main(int argc, char* argv[])
+{
+	if(argc != 3)
+	{
+		printf("Usage : %s trace_a trace_b\n", argv[0]);
+		return 2;
+	}
+	eTraceFile a, b;
+	if(!a.Open(argv[1]) || !b.Open(argv[2]))
+	{
+		printf("Error : unable to open traces\n");
+		return 2;
+	}
+	byte context[CONTEXT][RECORD_MAX];
+	qword records = 0;
+	for(;;)
+	{
+		bool more_a = a.Next();
+		bool more_b = b.Next();
+		if(!more_a && !more_b && a.size == b.size)
+		{
+			printf("Traces are identical: %llu records, %llu opcodes, %llu ints\n", records, a.steps, a.ints);
+			return 0;
+		}
+		if(!more_a || !more_b || a.size != b.size || memcmp(a.rec, b.rec, a.size))
+			break;
+		memcpy(context[records%CONTEXT], a.rec, a.size);
+		++records;
+	}
+	printf("Traces diverge at record %llu (opcode %llu, int %llu)\n", records, a.steps, a.ints);
+	for(qword i = records > CONTEXT ? records - CONTEXT : 0; i < records; ++i)
+		Print("  ", context[i%CONTEXT]);
+	if(a.size)
+		Print("a ", a.rec);
+	else
+		printf("a %s\n", gzeof(a.file) ? "ended" : "damaged");
+	if(b.size)
+		Print("b ", b.rec);
+	else
+		printf("b %s\n", gzeof(b.file) ? "ended" : "damaged");
+	return 1;
+}
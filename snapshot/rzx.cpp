@@ -41,44 +41,161 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "../platform/io.h"
 #include "../tools/stream_memory.h"
 #include "../options_common.h"
+#include "../tools/packer.h"
 #include "rzx.h"
 
 #ifdef USE_ZIP
 #include <zlib.h>
-#endif
+#include "../tools/job_thread.h"
+#endif//USE_ZIP
+
+#ifdef USE_ZIP
+//*****************************************************************************
+//	eUnpacker
+//-----------------------------------------------------------------------------
+// inflates packed recording block ahead of replay into two chunks in turn
+// (in job thread where available), so fetching of frame is plain copy from
+// memory. the only wait is when the whole chunk is consumed
+//-----------------------------------------------------------------------------
+class eUnpacker
+{
+public:
+	eUnpacker() : active(false)
+	{
+		for(int i = 0; i < 2; ++i)
+		{
+			jobs[i].unpacker = this;
+			jobs[i].i = i;
+		}
+	}
+	~eUnpacker() { Stop(); }
+	bool Start(const byte* src, size_t src_size);
+	void Stop();
+	size_t Read(byte* dst, size_t size);
+	size_t Pos() const { return total; } // bytes read since start
+
+private:
+	bool Next();
+	void Fill(int i);
+	struct eFillJob : public eJobThread::eJob
+	{
+		virtual void Execute() { unpacker->Fill(i); }
+		eUnpacker* unpacker;
+		int i;
+	};
+	enum { CHUNK_SIZE = 32768 };
+	z_stream zs;
+	byte chunk[2][CHUNK_SIZE];
+	size_t chunk_size[2];
+	bool finished;		// no more chunks after filled ones
+	bool active;
+	int cur;
+	size_t pos;
+	size_t total;
+	eFillJob jobs[2];
+	eJobThread thread;	// started on first fill
+};
+
+bool eUnpacker::Start(const byte* src, size_t src_size)
+{
+	Stop();
+	memset(&zs, 0, sizeof(zs));
+	zs.next_in = (Bytef*)src;
+	zs.avail_in = src_size;
+	if(inflateInit2(&zs, 15) != Z_OK)
+		return false;
+	active = true;
+	finished = false;
+	chunk_size[0] = chunk_size[1] = 0;
+	cur = 1; // first Next() switches to chunk 0
+	pos = total = 0;
+	thread.Start(&jobs[0]);
+	return true;
+}
+void eUnpacker::Stop()
+{
+	if(!active)
+		return;
+	thread.Wait();
+	inflateEnd(&zs);
+	active = false;
+}
+// inflate next portion of data, called by job thread or by reader itself
+void eUnpacker::Fill(int i)
+{
+	zs.next_out = chunk[i];
+	zs.avail_out = CHUNK_SIZE;
+	int r = inflate(&zs, Z_NO_FLUSH);
+	chunk_size[i] = CHUNK_SIZE - zs.avail_out;
+	// all input is given at once, so chunk isn't full only at stream end or error
+	if(r != Z_OK || zs.avail_out)
+		finished = true;
+}
+// current chunk consumed, switch to the other one
+bool eUnpacker::Next()
+{
+	if(!active)
+		return false;
+	thread.Wait();
+	cur ^= 1;
+	pos = 0;
+	// consumed chunk is refilled while this one is read
+	if(finished)
+		chunk_size[cur ^ 1] = 0;
+	else
+		thread.Start(&jobs[cur ^ 1]);
+	return chunk_size[cur] != 0;
+}
+size_t eUnpacker::Read(byte* dst, size_t size)
+{
+	size_t done = 0;
+	while(done < size)
+	{
+		if(pos == chunk_size[cur] && !Next())
+			break;
+		size_t s = chunk_size[cur] - pos;
+		if(s > size - done)
+			s = size - done;
+		memcpy(dst + done, chunk[cur] + pos, s);
+		pos += s;
+		done += s;
+	}
+	total += done;
+	return done;
+}
+#endif//USE_ZIP
 
 class eRZX::eImpl
 {
 public:
 	eImpl() : status(0), file(NULL), handler(NULL), framecount(0), INmax(0), INcount(0), INold(0)
-		, inputbuffer(NULL)
-#ifdef USE_ZIP
-		,zbuf(NULL)
-#endif//USE_ZIP
+		, inputbuffer(NULL), frame(0)
 	{}
 	~eImpl() { Close(); }
-	eError Open(const void* data, size_t data_size, eHandler* handler);
+	eError Open(xIo::eFileData* file, eHandler* handler);
 	eError Update(int* icount);
 	eError IoRead(byte* data);
 	eError CheckSync() const { return INcount == INmax ? E_OK : E_SYNC_LOST; }
+	int Frame() const { return frame; }
+	ePos Pos() const { return pos; }
+	eError Seek(const ePos& p);
 
 private:
 	class eStream : public xIo::eStreamMemory
 	{
 	public:
-		eStream(const void* _data, size_t _data_size) : xIo::eStreamMemory(_data, _data_size)
+		eStream(xIo::eFileData* _file) : xIo::eStreamMemory(_file->Data(), _file->Size()), file(_file->AddRef())
 		{
-			// we need copy of the data
-			byte* d = new byte[data_size];
-			memcpy(d, _data, data_size);
-			data = d;
 			Open();
 		}
 		~eStream()
 		{
 			Close();
-			SAFE_DELETE_ARRAY(data);
+			file->Release();
 		}
+		const byte* Ptr() const { return ptr; }
+	protected:
+		xIo::eFileData* file;
 	};
 	enum eBlockId
 	{
@@ -97,7 +214,7 @@ private:
 		RZX_PACK	= 0x08,
 	};
 
-	enum { RZXBLKBUF = 512, RZXINPUTMAX = 32768 };
+	enum { RZXBLKBUF = 512, RZXINPUTMAX = 65536 };
 	byte status;
 	eStream* file;
 	eHandler* handler;
@@ -118,15 +235,19 @@ private:
 	word INold;
 	byte* inputbuffer;
 
+	/* where frame fetched last is, to seek back to it */
+	ePos pos;
+	int frame;
+
 #ifdef USE_ZIP
-	enum { ZBUFLEN = 16384 };
-	z_stream zs;
-	byte* zbuf;
-	int ZipOpen();
-	int ZipRead(byte* buffer, int len);
-	int ZipClose();
+	eUnpacker unpacker;
+	static bool Inflate(const byte* src, size_t src_size, byte* dst, size_t dst_size);
 #endif//USE_ZIP
+	size_t BlockLeft() const { return block.start + block.length - file->Pos(); }
 	eError ReadBlock();
+	size_t ReadData(byte* dst, size_t size);
+	dword DataPos() const;
+	bool SeekData(const eFramePos& p);
 	void Close();
 };
 
@@ -134,53 +255,25 @@ private:
 /* ======================================================================== */
 
 #ifdef USE_ZIP
-int eRZX::eImpl::ZipRead(byte *buffer, int len)
-{
-	zs.next_out = buffer;
-	zs.avail_out = len;
-	while(zs.avail_out > 0)
-	{
-		if(zs.avail_in == 0)
-		{
-			zs.avail_in = file->Read(zbuf, ZBUFLEN);
-			if(zs.avail_in == 0)
-				return 0;
-			zs.next_in = zbuf;
-		}
-		inflate(&zs, Z_NO_FLUSH);
-	}
-	return len - zs.avail_out;
-}
-
-int eRZX::eImpl::ZipClose()
-{
-	if(zbuf != 0)
-	{
-		inflateEnd(&zs);
-		free(zbuf);
-		zbuf = 0;
-	}
-	return 0;
-}
-
-int eRZX::eImpl::ZipOpen()
+bool eRZX::eImpl::Inflate(const byte* src, size_t src_size, byte* dst, size_t dst_size)
 {
+	z_stream zs;
 	memset(&zs, 0, sizeof(zs));
-	assert(!zbuf);
-	zbuf = (byte*)malloc(ZBUFLEN);
-	zs.next_in = zbuf;
-	int err = inflateInit2(&zs, 15);
-	zs.avail_out = ZBUFLEN;
-	if(err != Z_OK)
-		return -1;
-	return 0;
+	zs.next_in = (Bytef*)src;
+	zs.avail_in = src_size;
+	zs.next_out = dst;
+	zs.avail_out = dst_size;
+	if(inflateInit2(&zs, 15) != Z_OK)
+		return false;
+	int r = inflate(&zs, Z_FINISH);
+	inflateEnd(&zs);
+	return (r == Z_STREAM_END || r == Z_OK || r == Z_BUF_ERROR) && !zs.avail_out;
 }
 #endif//USE_ZIP
 
 eRZX::eError eRZX::eImpl::ReadBlock()
 {
 	int done = 0;
-	long fpos;
 	while(!done)
 	{
 		if(file->Read(block.buff, 5) < 5)
@@ -198,34 +291,20 @@ eRZX::eError eRZX::eImpl::ReadBlock()
 				if(!(block.buff[0] & 0x01))
 				{
 					/* embedded snap */
-#ifdef USE_ZIP
 					bool compressed = (block.buff[0] & 0x02) != 0;
-					fpos = file->Pos();
-					ZipOpen();
-#endif
 					strcpy(snap_filename, (const char*)block.buff + 4);
 					size_t snap_size = block.buff[8]+256*block.buff[9]+65536*block.buff[10]+16777216*block.buff[11];
 					byte* snap_data = new byte[snap_size];
-					byte* snap_pos = snap_data;
-					fpos = snap_size;
-					while(fpos > 0)
+					bool ok = false;
+					if(compressed)
 					{
-						done = (fpos > RZXBLKBUF) ? RZXBLKBUF : fpos;
 #ifdef USE_ZIP
-						if(compressed)
-							ZipRead(block.buff, done);
-						else
-#endif
-							file->Read(block.buff, done);
-						memcpy(snap_pos, block.buff, done);
-						snap_pos += done;
-						fpos -= done;
+						ok = Inflate(file->Ptr(), BlockLeft(), snap_data, snap_size);
+#endif//USE_ZIP
 					}
-#ifdef USE_ZIP
-					ZipClose();
-#endif
-					done = 0;
-					bool ok = handler->RZX_OnOpenSnapshot(snap_filename, snap_data, snap_size);
+					else
+						ok = file->Read(snap_data, snap_size) == snap_size;
+					ok = ok && handler->RZX_OnOpenSnapshot(snap_filename, snap_data, snap_size);
 					SAFE_DELETE_ARRAY(snap_data);
 					if(!ok)
 						return E_UNSUPPORTED;
@@ -268,8 +347,8 @@ eRZX::eError eRZX::eImpl::ReadBlock()
 				return E_UNSUPPORTED;
 #else//USE_ZIP
 			{
-				fpos = file->Pos();
-				ZipOpen();
+				if(!unpacker.Start(file->Ptr(), BlockLeft()))
+					return E_INVALID;
 			}
 #endif
 			return E_OK;
@@ -285,10 +364,10 @@ eRZX::eError eRZX::eImpl::ReadBlock()
 }
 
 
-eRZX::eError eRZX::eImpl::Open(const void* _data, size_t _data_size, eHandler* _handler)
+eRZX::eError eRZX::eImpl::Open(xIo::eFileData* _file, eHandler* _handler)
 {
 	assert(!file);
-	file = new eStream(_data, _data_size);
+	file = new eStream(_file);
 	handler = _handler;
 	if(!handler)
 		return E_INVALID;
@@ -322,11 +401,79 @@ eRZX::eError eRZX::eImpl::Open(const void* _data, size_t _data_size, eHandler* _
 void eRZX::eImpl::Close()
 {
 #ifdef USE_ZIP
-	ZipClose();
+	unpacker.Stop();
 #endif//USE_ZIP
 	SAFE_DELETE(file);
 	status = RZX_INIT;
 	SAFE_DELETE_ARRAY(inputbuffer);
+	frame = 0;
+}
+
+size_t eRZX::eImpl::ReadData(byte* dst, size_t size)
+{
+#ifdef USE_ZIP
+	if(status & RZX_PACK)
+		return unpacker.Read(dst, size);
+#endif//USE_ZIP
+	return file->Read(dst, size);
+}
+/* position in recording block data, 18 bytes of block header skipped */
+dword eRZX::eImpl::DataPos() const
+{
+#ifdef USE_ZIP
+	if(status & RZX_PACK)
+		return unpacker.Pos();
+#endif//USE_ZIP
+	return file->Pos() - block.start - 18;
+}
+bool eRZX::eImpl::SeekData(const eFramePos& p)
+{
+	if(block.start != p.block || !(status & RZX_IRB) || p.offset < DataPos())
+	{
+		/* (re)start the block, packed data can't be read backwards */
+#ifdef USE_ZIP
+		unpacker.Stop();
+#endif//USE_ZIP
+		block.start = p.block;
+		if(file->Seek(block.start) != 0 || ReadBlock() != E_OK)
+			return false;
+	}
+	framecount = p.left;
+	dword skip = p.offset - DataPos();
+#ifdef USE_ZIP
+	if(status & RZX_PACK)
+	{
+		while(skip)
+		{
+			size_t s = skip < RZXBLKBUF ? skip : RZXBLKBUF;
+			if(unpacker.Read(block.buff, s) != s)
+				return false;
+			skip -= s;
+		}
+		return true;
+	}
+#endif//USE_ZIP
+	return file->Seek(file->Pos() + skip) == 0;
+}
+eRZX::eError eRZX::eImpl::Seek(const ePos& p)
+{
+	if(!file || p.frame < 0)
+		return E_INVALID;
+	if(p.input.block != p.at.block || p.input.offset != p.at.offset)
+	{
+		/* input data of repeating frame comes from the frame it repeats */
+		if(!SeekData(p.input) || ReadData(block.buff, 4) != 4)
+			return E_INVALID;
+		INmax = block.buff[2] + 256 * block.buff[3];
+		if(ReadData(inputbuffer, INmax) != INmax)
+			return E_INVALID;
+	}
+	if(!SeekData(p.at))
+		return E_INVALID;
+	INcount = 0;
+	frame = p.frame;
+	pos = p;
+	return E_OK;
 }
 
 
@@ -339,10 +486,10 @@ eRZX::eError eRZX::eImpl::Update(int* icount)
 	if(!(status & RZX_IRB))
 	{
 #ifdef USE_ZIP
-		ZipClose();
+		unpacker.Stop();
 #endif//USE_ZIP
 		block.start += block.length;
-		if(file->Seek(block.start) != 0) // bugfix with possible buffer overread when readed zipped data
+		if(file->Seek(block.start) != 0)
 			return E_INVALID;
 		eError err = ReadBlock();
 		if(err != E_OK)
@@ -355,32 +502,29 @@ eRZX::eError eRZX::eImpl::Update(int* icount)
 
 	/* fetch the instruction and IN counters */
 	INold = INmax;
-#ifdef USE_ZIP
-	if(status & RZX_PACK)
-		ZipRead(block.buff, 4);
-	else
-#endif
-		file->Read(block.buff, 4);
+	dword offset = DataPos();
+	ReadData(block.buff, 4);
 	(*icount) = block.buff[0] + 256 * block.buff[1];
 	INmax = block.buff[2] + 256 * block.buff[3];
 
+	/* remember where the frame is */
+	eFramePos p = { block.start, offset, framecount };
+	pos.frame = frame;
+	pos.at = p;
+	if(INmax != 0xFFFF || !frame)
+		pos.input = p;
+
 	/* update the input array */
 	if(INmax != 0xFFFF)
 	{
 		if(INmax)
-		{
-#ifdef USE_ZIP
-			if(status & RZX_PACK)
-				ZipRead(inputbuffer, INmax);
-			else
-#endif//USE_ZIP
-				file->Read(inputbuffer, INmax);
-		}
+			ReadData(inputbuffer, INmax);
 	}
 	else
 		INmax = INold;
 	INcount = 0;
 	--framecount;
+	++frame;
 	return E_OK;
 }
 eRZX::eError eRZX::eImpl::IoRead(byte* data)
@@ -393,7 +537,173 @@ eRZX::eError eRZX::eImpl::IoRead(byte* data)
 
 eRZX::eRZX() { impl = new eImpl; }
 eRZX::~eRZX() { delete impl; }
-eRZX::eError eRZX::Open(const void* data, size_t data_size, eHandler* handler) { return impl->Open(data, data_size, handler); }
+eRZX::eError eRZX::Open(xIo::eFileData* file, eHandler* handler) { return impl->Open(file, handler); }
+
 eRZX::eError eRZX::Update(int* icount) { return impl->Update(icount); }
 eRZX::eError eRZX::IoRead(byte* data) { return impl->IoRead(data); }
 eRZX::eError eRZX::CheckSync() const { return impl->CheckSync(); }
+int eRZX::Frame() const { return impl->Frame(); }
+eRZX::ePos eRZX::Pos() const { return impl->Pos(); }
+eRZX::eError eRZX::Seek(const ePos& p) { return impl->Seek(p); }
+
+class eRZXRecord::eImpl
+{
+public:
+	eImpl() : file(NULL), irb_start(0), frames(0), in_count(0), in_last_count(-1)
+	{
+		in = new byte[INPUT_MAX];
+		in_last = new byte[INPUT_MAX];
+	}
+	~eImpl()
+	{
+		Close();
+		SAFE_DELETE_ARRAY(in);
+		SAFE_DELETE_ARRAY(in_last);
+	}
+	bool Open(const char* name, const void* snapshot, size_t snapshot_size, const char* type);
+	bool Close();
+	void IoRead(byte data)
+	{
+		if(in_count < INPUT_MAX)
+			in[in_count++] = data;
+	}
+	void Frame(int fetches);
+
+private:
+	enum { INPUT_MAX = 0xFFFE }; // 0xFFFF input count means the same input as in previous frame
+	static void PutDword(byte* p, dword v)
+	{
+		p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24;
+	}
+	void Write(const void* data, size_t size)
+	{
+#ifdef USE_ZIP
+		packer.Write((const byte*)data, size);
+#else//USE_ZIP
+		fwrite(data, 1, size, file);
+#endif//USE_ZIP
+	}
+
+	FILE* file;
+	long irb_start;
+	dword frames;
+	byte* in;
+	byte* in_last;
+	int in_count;
+	int in_last_count;
+#ifdef USE_ZIP
+	xIo::ePacker packer;
+#endif//USE_ZIP
+};
+
+bool eRZXRecord::eImpl::Open(const char* name, const void* snapshot, size_t snapshot_size, const char* type)
+{
+	Close();
+	file = fopen(name, "wb");
+	if(!file)
+		return false;
+	byte buff[64];
+	memset(buff, 0, sizeof(buff));
+	/* header, version 0.13 */
+	memcpy(buff, "RZX!", 4);
+	buff[5] = 13;
+	/* creator block */
+	buff[10] = 0x10;
+	PutDword(buff + 11, 29);
+	strcpy((char*)buff + 15, "Unreal Speccy");
+	bool ok = fwrite(buff, 1, 39, file) == 39;
+	/* embedded snapshot block */
+	const byte* snap = (const byte*)snapshot;
+	size_t snap_size = snapshot_size;
+	dword flags = 0;
+#ifdef USE_ZIP
+	uLongf packed_size = compressBound(snapshot_size);
+	byte* packed = new byte[packed_size];
+	if(compress2(packed, &packed_size, snap, snapshot_size, Z_DEFAULT_COMPRESSION) == Z_OK)
+	{
+		snap = packed;
+		snap_size = packed_size;
+		flags = 0x02;
+	}
+#endif//USE_ZIP
+	memset(buff, 0, sizeof(buff));
+	buff[0] = 0x30;
+	PutDword(buff + 1, 17 + snap_size);
+	PutDword(buff + 5, flags);
+	strncpy((char*)buff + 9, type, 3);
+	PutDword(buff + 13, snapshot_size);
+	ok = ok && fwrite(buff, 1, 17, file) == 17;
+	ok = ok && fwrite(snap, 1, snap_size, file) == snap_size;
+#ifdef USE_ZIP
+	SAFE_DELETE_ARRAY(packed);
+#endif//USE_ZIP
+	/* input recording block, length & frame count are filled on close */
+	irb_start = ftell(file);
+	memset(buff, 0, sizeof(buff));
+	buff[0] = 0x80;
+#ifdef USE_ZIP
+	buff[14] = 0x02;
+#endif//USE_ZIP
+	ok = ok && fwrite(buff, 1, 18, file) == 18;
+#ifdef USE_ZIP
+	ok = ok && packer.Start(file);
+#endif//USE_ZIP
+	if(!ok)
+	{
+		fclose(file);
+		file = NULL;
+		remove(name);
+		return false;
+	}
+	frames = 0;
+	in_count = 0;
+	in_last_count = -1;
+	return true;
+}
+bool eRZXRecord::eImpl::Close()
+{
+	if(!file)
+		return false;
+	bool ok = true;
+#ifdef USE_ZIP
+	ok = packer.Finish();
+#endif//USE_ZIP
+	long end = ftell(file);
+	byte buff[4];
+	PutDword(buff, end - irb_start);
+	ok = ok && fseek(file, irb_start + 1, SEEK_SET) == 0 && fwrite(buff, 1, 4, file) == 4;
+	PutDword(buff, frames);
+	ok = ok && fwrite(buff, 1, 4, file) == 4;
+	ok = fclose(file) == 0 && ok;
+	file = NULL;
+	return ok;
+}
+void eRZXRecord::eImpl::Frame(int fetches)
+{
+	if(!file)
+		return;
+	bool same = in_count && in_count == in_last_count && !memcmp(in, in_last, in_count);
+	word count = same ? 0xFFFF : in_count;
+	byte buff[4];
+	buff[0] = fetches; buff[1] = fetches >> 8;
+	buff[2] = count; buff[3] = count >> 8;
+	Write(buff, 4);
+	if(!same)
+	{
+		Write(in, in_count);
+		byte* t = in_last;
+		in_last = in;
+		in = t;
+		in_last_count = in_count;
+	}
+	in_count = 0;
+	++frames;
+}
+
+eRZXRecord::eRZXRecord() { impl = new eImpl; }
+eRZXRecord::~eRZXRecord() { delete impl; }
+bool eRZXRecord::Open(const char* name, const void* snapshot, size_t snapshot_size, const char* type) { return impl->Open(name, snapshot, snapshot_size, type); }
+bool eRZXRecord::Close() { return impl->Close(); }
+
+void eRZXRecord::IoRead(byte data) { impl->IoRead(data); }
+void eRZXRecord::Frame(int fetches) { impl->Frame(fetches); }
@@ -21,6 +21,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "../std_types.h"
 
+namespace xIo
+{
+class eFileData;
+}
+//namespace xIo
+
 class eRZX
 {
 public:
@@ -35,11 +41,48 @@ public:
 		virtual bool RZX_OnOpenSnapshot(const char* name, const void* data, size_t data_size) = 0;
 	};
 
-	eError Open(const void* data, size_t data_size, eHandler* handler);
+	eError Open(xIo::eFileData* file, eHandler* handler); // keeps reference to file
+
 	eError Update(int* icount);
 	eError IoRead(byte* data);
 	eError CheckSync() const;
 
+	// where frame is in file, to seek back to it
+	struct eFramePos
+	{
+		long	block;	// start of input recording block
+		dword	offset;	// of frame in (unpacked) block data
+		dword	left;	// frames left in block, this one included
+	};
+	struct ePos
+	{
+		int		frame;
+		eFramePos at;
+		eFramePos input; // of frame whose input data is used (repeated) by this one
+	};
+
+	int Frame() const;			// frames fetched by Update() so far
+	ePos Pos() const;			// of frame fetched last by Update()
+	eError Seek(const ePos& p);	// next Update() fetches that frame again
+
+private:
+	class eImpl;
+	eImpl* impl;
+};
+
+class eRZXRecord
+{
+public:
+	eRZXRecord();
+	~eRZXRecord(); // closes file if still open
+
+	// snapshot - initial state of emulator, type - its file type ("szx")
+	bool Open(const char* name, const void* snapshot, size_t snapshot_size, const char* type);
+	bool Close();
+
+	void IoRead(byte data);		// value read by cpu during current frame
+	void Frame(int fetches);	// frame finished with given count of opcode fetches
+
 private:
 	class eImpl;
 	eImpl* impl;
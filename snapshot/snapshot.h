@@ -29,6 +29,8 @@ namespace xSnapshot
 {
 bool Load(eSpeccy* speccy, const char* type, const void* data, size_t data_size);
 bool Store(eSpeccy* speccy, const char* file);
+enum { SZX_SIZE_MAX = 132*1024 };
+size_t StoreSZX(eSpeccy* speccy, void* data); // into data of SZX_SIZE_MAX, returns size stored
 }
 //namespace xSnapshot
 
@@ -152,6 +152,7 @@ typedef struct _tagZXSTAYBLOCK
 struct eZ80AccessorSZX : public xZ80::eZ80
 {
 	bool SetState(xIo::eStreamMemory& is);
+	size_t StoreState(byte* data);
 	void SetupDevices(bool model48k)
 	{
 		devices->Get<eRom>()->Mode48k(model48k);
@@ -168,6 +169,13 @@ template<class B> static bool ReadBlock(xIo::eStreamMemory& is, B* b, const ZXST
 		size = b->blk.dwSize;
 	return is.Read((byte*)b + sizeof(b->blk), size) == size;
 }
+template<class B> static byte* WriteBlock(byte* data, B* b, dword id, size_t size = sizeof(B), size_t data_size = 0)
+{
+	b->blk.dwId = id;
+	b->blk.dwSize = size - sizeof(b->blk) + data_size;
+	memcpy(data, b, size);
+	return data + size;
+}
 
 bool eZ80AccessorSZX::SetState(xIo::eStreamMemory& is)
 {
@@ -304,6 +312,80 @@ bool eZ80AccessorSZX::SetState(xIo::eStreamMemory& is)
 	return false;
 }
 
+size_t eZ80AccessorSZX::StoreState(byte* data)
+{
+	bool model48k = devices->Get<eRam>()->Mode48k();
+	byte* p = data;
+	ZXSTHEADER header;
+	header.dwMagic = FOURCC('Z', 'X', 'S', 'T');
+	header.chMajorVersion = 1;
+	header.chMinorVersion = 4;
+	header.chMachineId = model48k ? ZXSTMID_48K : ZXSTMID_PENTAGON128;
+	header.chFlags = 0;
+	memcpy(p, &header, sizeof(header));
+	p += sizeof(header);
+
+	ZXSTZ80REGS regs;
+	memset(&regs, 0, sizeof(regs));
+	regs.AF = SwapWord(af);
+	regs.BC = SwapWord(bc);
+	regs.DE = SwapWord(de);
+	regs.HL = SwapWord(hl);
+	regs.AF1 = SwapWord(alt.af);
+	regs.BC1 = SwapWord(alt.bc);
+	regs.DE1 = SwapWord(alt.de);
+	regs.HL1 = SwapWord(alt.hl);
+	regs.IX = SwapWord(ix);
+	regs.IY = SwapWord(iy);
+	regs.SP = SwapWord(sp);
+	regs.PC = SwapWord(pc);
+	regs.I = i;
+	regs.R = (r_low & 0x7F) + r_hi;
+	regs.IFF1 = iff1;
+	regs.IFF2 = iff2;
+	regs.IM = im;
+	byte* cycles = (byte*)&regs.dwCyclesStart;
+	cycles[0] = t; cycles[1] = t >> 8; cycles[2] = t >> 16; cycles[3] = t >> 24;
+	if(t == eipos)
+		regs.chFlags |= ZXSTZF_EILAST;
+	if(halted)
+		regs.chFlags |= ZXSTZF_HALTED;
+	regs.wMemPtr = SwapWord(memptr);
+	p = WriteBlock(p, &regs, FOURCC('Z', '8', '0', 'R'));
+
+	ZXSTSPECREGS spec;
+	memset(&spec, 0, sizeof(spec));
+	spec.chBorder = devices->Get<eUla>()->BorderColor();
+	spec.ch7ffd = memory->Page(3) - eMemory::P_RAM0;
+	if(!devices->Get<eUla>()->FirstScreen())
+		spec.ch7ffd |= 0x08;
+	if(devices->Get<eRom>()->Page() != eRom::ROM_128_1) // tr-dos pages in over basic48 only
+		spec.ch7ffd |= 0x10;
+	p = WriteBlock(p, &spec, FOURCC('S', 'P', 'C', 'R'));
+
+	for(int i = 0; i < 8; ++i)
+	{
+		if(model48k && i != 0 && i != 2 && i != 5)
+			continue;
+		ZXSTRAMPAGE ram_page;
+		ram_page.wFlags = 0;
+		ram_page.chPageNo = i;
+		p = WriteBlock(p, &ram_page, FOURCC('R', 'A', 'M', 'P'), sizeof(ZXSTRAMPAGE) - 1, eMemory::PAGE_SIZE);
+		memcpy(p, memory->Get(eMemory::P_RAM0 + i), eMemory::PAGE_SIZE);
+
+		p += eMemory::PAGE_SIZE;
+	}
+	if(!model48k)
+	{
+		ZXSTAYBLOCK ay_state;
+		ay_state.chFlags = ZXSTAYF_128AY;
+		ay_state.chCurrentRegister = devices->Get<eAY>()->Selected();
+		memcpy(ay_state.chAyRegs, devices->Get<eAY>()->Regs(), sizeof(ay_state.chAyRegs));
+		p = WriteBlock(p, &ay_state, FOURCC('A', 'Y', '\0', '\0'));
+	}
+	return p - data;
+}
+
 bool LoadSZX(eSpeccy* speccy, const void* data, size_t data_size)
 {
 	xIo::eStreamMemory is(data, data_size);
@@ -312,5 +394,11 @@ bool LoadSZX(eSpeccy* speccy, const void* data, size_t data_size)
 	return z80->SetState(is);
 }
 
+size_t StoreSZX(eSpeccy* speccy, void* data)
+{
+	eZ80AccessorSZX* z80 = (eZ80AccessorSZX*)speccy->CPU();
+	return z80->StoreState((byte*)data);
+}
+
 }
 //namespace xSnapshot
@@ -41,7 +41,7 @@ PROFILER_DECLARE(frame);
 //	eSpeccy::eSpeccy
 //-----------------------------------------------------------------------------
 eSpeccy::eSpeccy() : cpu(NULL), memory(NULL), frame_tacts(0)
-	, int_len(0), nmi_pending(0), t_states(0)
+	, int_len(0), nmi_pending(0), t_states(0), beta_disk(true)
 {
 	// pentagon timings
 	frame_tacts = 71680;
@@ -95,6 +95,26 @@ void eSpeccy::Mode48k(bool on)
 	Device<eUla>()->Mode48k(on);
 }
 //=============================================================================
+//	eSpeccy::Model
+//-----------------------------------------------------------------------------
+eSpeccy::eModel eSpeccy::Model() const
+{
+	// paged in tr-dos needs paging check to close it even without beta disk
+	if(!beta_disk && !Device<eRom>()->DosSelected())
+		return Mode48k() ? M_48K : M_128K;
+	return Mode48k() ? M_GENERIC : M_PENTAGON;
+}
+//=============================================================================
+//	eSpeccy::UpdateCpu
+//-----------------------------------------------------------------------------
+template<class M> void eSpeccy::UpdateCpu(int* fetches)
+{
+	if(fetches)
+		cpu->Replay<M>(*fetches);
+	else
+		cpu->Update<M>(int_len, &nmi_pending);
+}
+//=============================================================================
 //	eSpeccy::Update
 //-----------------------------------------------------------------------------
 void eSpeccy::Update(int* fetches)
@@ -105,10 +125,13 @@ void eSpeccy::Update(int* fetches)
 	}
 	{
 		PROFILER_SECTION(frame);
-		if(fetches)
-			cpu->Replay(*fetches);
-		else
-			cpu->Update(int_len, &nmi_pending);
+		switch(Model())
+		{
+		case M_48K:			UpdateCpu<xZ80::eModel48k>(fetches);		break;
+		case M_128K:		UpdateCpu<xZ80::eModel128k>(fetches);		break;
+		case M_PENTAGON:	UpdateCpu<xZ80::eModelPentagon>(fetches);	break;
+		default:			UpdateCpu<xZ80::eModelGeneric>(fetches);	break;
+		}
 	}
 	{
 		PROFILER_SECTION(dev);
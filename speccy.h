@@ -52,6 +52,15 @@ public:
 	bool Mode48k() const;
 	void Mode48k(bool on);
 
+	bool BetaDisk() const { return beta_disk; }
+	void BetaDisk(bool on) { beta_disk = on; }
+
+	enum eModel { M_GENERIC, M_48K, M_128K, M_PENTAGON };
+	eModel Model() const;
+
+protected:
+	template<class M> void UpdateCpu(int* fetches);
+
 protected:
 	xZ80::eZ80* cpu;
 	eMemory* memory;
@@ -61,6 +70,7 @@ protected:
 	int		int_len;		// length of INT signal (for Z80)
 	int		nmi_pending;
 	qword	t_states;
+	bool	beta_disk;		// tr-dos rom pages in at #3dxx
 };
 
 #endif//__SPECCY_H__
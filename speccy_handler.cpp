@@ -30,6 +30,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "devices/sound/beeper.h"
 #include "devices/fdd/wd1793.h"
 #include "z80/z80.h"
+#include "z80/z80_trace.h"
 #include "snapshot/snapshot.h"
 #include "platform/io.h"
 #include "ui/ui_desktop.h"
@@ -40,6 +41,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "file_type.h"
 #include "gameconfig.h"
 #include "snapshot/rzx.h"
+#include "tools/file_writer.h"
+#include "file_type_zip.h"
+#include <vector>
+#ifdef USE_ZIP
+#include <zlib.h>
+#endif//USE_ZIP
 int gcw_fullscreen = 1;
 
 namespace xPlatform
@@ -60,9 +67,115 @@ protected:
 	int frame;
 };
 
+//*****************************************************************************
+//	eKeyframes
+//-----------------------------------------------------------------------------
+// emulator states captured every 'step' frames of .rzx replay to seek back to
+// any frame played. packed .szx is kept with rom page, as TR-DOS rom being
+// active isn't stored in .szx, and with position of the frame in .rzx.
+// when they take too much memory every other one is dropped and step is doubled.
+// they're taken & restored between frames only, where ula has no events logged
+// and its ray is at frame start (flash phase isn't kept). tape & disk state isn't
+// kept either: replay takes port reads from .rzx so cpu doesn't depend on them,
+// and no keyframe is taken or restored while tape plays or disk controller is
+// busy (see ReplaySeekable())
+//-----------------------------------------------------------------------------
+class eKeyframes
+{
+public:
+	eKeyframes() { Clear(); }
+	void Clear() { keyframes.clear(); size = 0; step = STEP_MIN; }
+	void Store(eSpeccy* speccy, eRZX* replay);		// before frame fetched last, if it's time to
+	int Find(int frame) const;						// frame of the nearest one not after given, -1 if none
+	bool Restore(eSpeccy* speccy, eRZX* replay, int frame) const; // the one found by Find()
+private:
+	enum { STEP_MIN = 5*50, MEMORY_MAX = 32*1024*1024 };
+	struct eKeyframe
+	{
+		eRZX::ePos pos;
+		int rom_page;
+		std::vector<byte> state;
+	};
+	std::vector<eKeyframe> keyframes;
+	size_t size;
+	int step;
+};
+
+void eKeyframes::Store(eSpeccy* speccy, eRZX* replay)
+{
+	int frame = replay->Frame() - 1;
+	if(frame % step || (!keyframes.empty() && keyframes.back().pos.frame >= frame))
+		return;
+	byte* szx = new byte[xSnapshot::SZX_SIZE_MAX];
+	size_t szx_size = xSnapshot::StoreSZX(speccy, szx);
+	if(szx_size)
+	{
+		keyframes.push_back(eKeyframe());
+		eKeyframe& k = keyframes.back();
+		k.pos = replay->Pos();
+		k.rom_page = speccy->Device<eRom>()->Page();
+#ifdef USE_ZIP
+		uLongf packed_size = compressBound(szx_size);
+		k.state.resize(packed_size);
+		if(compress2(&k.state[0], &packed_size, szx, szx_size, Z_BEST_SPEED) == Z_OK)
+			k.state.resize(packed_size);
+		else
+			k.state.assign(szx, szx + szx_size);
+#else//USE_ZIP
+		k.state.assign(szx, szx + szx_size);
+#endif//USE_ZIP
+		size += k.state.size();
+	}
+	SAFE_DELETE_ARRAY(szx);
+	if(size <= MEMORY_MAX)
+		return;
+	step *= 2;
+	size = 0;
+	size_t kept = 0;
+	for(size_t i = 0; i < keyframes.size(); ++i)
+	{
+		if(keyframes[i].pos.frame % step)
+			continue;
+		keyframes[kept].pos = keyframes[i].pos;
+		keyframes[kept].rom_page = keyframes[i].rom_page;
+		keyframes[kept].state.swap(keyframes[i].state);
+		size += keyframes[kept++].state.size();
+	}
+	keyframes.resize(kept);
+}
+int eKeyframes::Find(int frame) const
+{
+	for(int i = keyframes.size(); --i >= 0;)
+	{
+		if(keyframes[i].pos.frame <= frame)
+			return keyframes[i].pos.frame;
+	}
+	return -1;
+}
+bool eKeyframes::Restore(eSpeccy* speccy, eRZX* replay, int frame) const
+{
+	int i = keyframes.size();
+	while(--i >= 0 && keyframes[i].pos.frame != frame);
+	if(i < 0)
+		return false;
+	const eKeyframe& k = keyframes[i];
+#ifdef USE_ZIP
+	byte* szx = new byte[xSnapshot::SZX_SIZE_MAX];
+	uLongf szx_size = xSnapshot::SZX_SIZE_MAX;
+	bool ok = uncompress(szx, &szx_size, &k.state[0], k.state.size()) == Z_OK;
+	ok = ok && xSnapshot::Load(speccy, "szx", szx, szx_size);
+	SAFE_DELETE_ARRAY(szx);
+#else//USE_ZIP
+	bool ok = xSnapshot::Load(speccy, "szx", &k.state[0], k.state.size());
+#endif//USE_ZIP
+	if(ok)
+		speccy->Device<eRom>()->SelectPage(k.rom_page);
+	return ok && replay->Seek(k.pos) == eRZX::E_OK;
+}
+
 static struct eSpeccyHandler : public eHandler, public eRZX::eHandler, public xZ80::eZ80::eHandlerIo
 {
-	eSpeccyHandler() : speccy(NULL), macro(NULL), replay(NULL), video_paused(0), inside_replay_update(false) {}
+	eSpeccyHandler() : speccy(NULL), macro(NULL), replay(NULL), recorder(NULL), trace(NULL), video_paused(0), inside_replay_update(false) {}
 	virtual ~eSpeccyHandler() { assert(!speccy); }
 	virtual void OnInit();
 	virtual void OnDone();
@@ -97,25 +210,45 @@ static struct eSpeccyHandler : public eHandler, public eRZX::eHandler, public xZ
 	virtual void AudioDataUse(int source, dword size) { sound_dev[source]->AudioDataUse(size); }
 	virtual void VideoPaused(bool paused) {	paused ? ++video_paused : --video_paused; }
 
-	virtual bool FullSpeed() const { return speccy->CPU()->HandlerStep() != NULL; }
+	virtual bool FullSpeed() const;
+	void SkipFrame(bool skip)
+	{
+		speccy->Device<eUla>()->Skip(skip);
+		for(int i = 0; i < SOUND_DEV_COUNT; ++i)
+			sound_dev[i]->Skip(skip);
+	}
+	virtual int ReplayFrame() const { return replay ? replay->Frame() : -1; }
+	virtual int OnReplaySeek(int frame);
+	virtual bool OnTrace(const char* name);
 
 	void PlayMacro(eMacro* m) { SAFE_DELETE(macro); macro = m; }
 	virtual bool RZX_OnOpenSnapshot(const char* name, const void* data, size_t data_size) { return OpenFile(name, data, data_size); }
 	virtual byte Z80_IoRead(word port, int tact)
 	{
 		byte r = 0xff;
-		replay->IoRead(&r);
+		if(replay)
+			replay->IoRead(&r);
+		else
+		{
+			r = speccy->Devices().IoRead(port, tact);
+			SAFE_CALL(recorder)->IoRead(r);
+		}
 		return r;
 	}
+	virtual void Z80_Frame(int fetches) { SAFE_CALL(recorder)->Frame(fetches); }
 	const char* RZXErrorDesc(eRZX::eError err) const;
 	void Replay(eRZX* r)
 	{
 		speccy->CPU()->HandlerIo(NULL);
 		SAFE_DELETE(replay);
 		replay = r;
+		keyframes.Clear();
 		if(replay)
 			speccy->CPU()->HandlerIo(this);
 	}
+	const char* ReplayUpdate();
+	bool ReplaySeekable() const;
+	bool Record(const char* name);
 
 	eSpeccy* speccy;
 	std::map<int, byte> m_poke;
@@ -124,6 +257,9 @@ static struct eSpeccyHandler : public eHandler, public eRZX::eHandler, public xZ
 #endif//USE_UI
 	eMacro* macro;
 	eRZX* replay;
+	eKeyframes keyframes;
+	eRZXRecord* recorder;
+	xZ80::eTrace* trace;
 	int video_paused;
 	bool inside_replay_update;
 
@@ -145,52 +281,116 @@ void eSpeccyHandler::OnInit()
 	xOptions::Load();
 	OnAction(A_RESET);
 }
+static void DiskWriteBack(bool flush);
+
 void eSpeccyHandler::OnDone()
 {
 	xOptions::Store();
+	DiskWriteBack(true);
+	xIo::WriteWait();
 	SAFE_DELETE(macro);
 	SAFE_DELETE(replay);
+	SAFE_DELETE(recorder);
+	OnTrace(NULL);
 	SAFE_DELETE(speccy);
 #ifdef USE_UI
 	SAFE_DELETE(ui_desktop);
 #endif//USE_UI
 	PROFILER_DUMP;
 }
+static int FastForwardFrames();
 const char* eSpeccyHandler::OnLoop()
 {
 	const char* error = NULL;
 	if(FullSpeed() || !video_paused)
 	{
-		if(macro)
+		// fast forward runs several frames, only the last one is drawn. it isn't
+		// heard either, as AudioSources() gives no sound while at full speed
+		int frames = FullSpeed() ? FastForwardFrames() : 1;
+		for(int f = 0; f < frames && !error; ++f)
 		{
-			if(!macro->Update())
-				SAFE_DELETE(macro);
-		}
-		if(replay)
-		{
-			int icount = 0;
-			inside_replay_update = true;
-			eRZX::eError err = replay->Update(&icount);
-			inside_replay_update = false;
-			if(err == eRZX::E_OK)
-			{
-				speccy->Update(&icount);
-				err = replay->CheckSync();
-			}
-			if(err != eRZX::E_OK)
+			if(frames > 1)
+				SkipFrame(f < frames - 1);
+			if(macro)
 			{
-				Replay(NULL);
-				error = RZXErrorDesc(err);
+				if(!macro->Update())
+					SAFE_DELETE(macro);
 			}
+			if(replay)
+				error = ReplayUpdate();
+			else
+				speccy->Update(NULL);
 		}
-		else
-			speccy->Update(NULL);
+		if(frames > 1)
+			SkipFrame(false);
+		DiskWriteBack(false);
 	}
 #ifdef USE_UI
 	ui_desktop->Update();
 #endif//USE_UI
 	return error;
 }
+// play next frame of .rzx (keyframe taken before if it's time to), replay stops on error
+const char* eSpeccyHandler::ReplayUpdate()
+{
+	int icount = 0;
+	inside_replay_update = true;
+	eRZX::eError err = replay->Update(&icount);
+	inside_replay_update = false;
+	if(err == eRZX::E_OK)
+	{
+		if(ReplaySeekable())
+			keyframes.Store(speccy, replay);
+		speccy->Update(&icount);
+		err = replay->CheckSync();
+	}
+	if(err != eRZX::E_OK)
+	{
+		Replay(NULL);
+		return RZXErrorDesc(err);
+	}
+	return NULL;
+}
+// state out of .szx isn't in the middle of operation, so keyframe may be taken or restored
+bool eSpeccyHandler::ReplaySeekable() const
+{
+	return !speccy->Device<eTape>()->Started() && !speccy->Device<eWD1793>()->Busy();
+}
+// restore the nearest keyframe (if going back or it's ahead) & play from it
+int eSpeccyHandler::OnReplaySeek(int frame)
+{
+	if(!replay)
+		return -1;
+	int k = keyframes.Find(frame);
+	if(k >= 0 && (frame < replay->Frame() || k > replay->Frame()) && ReplaySeekable())
+	{
+		if(!keyframes.Restore(speccy, replay, k))
+		{
+			Replay(NULL);
+			return -1;
+		}
+	}
+	SkipFrame(true);
+	while(replay && replay->Frame() < frame)
+		ReplayUpdate();
+	SkipFrame(false);
+	return ReplayFrame();
+}
+bool eSpeccyHandler::OnTrace(const char* name)
+{
+	speccy->CPU()->HandlerTrace(NULL);
+	SAFE_DELETE(trace);
+	if(!name)
+		return true;
+	trace = new xZ80::eTrace;
+	if(!trace->Open(name))
+	{
+		SAFE_DELETE(trace);
+		return false;
+	}
+	speccy->CPU()->HandlerTrace(trace);
+	return true;
+}
 const char* eSpeccyHandler::RZXErrorDesc(eRZX::eError err) const
 {
 	switch(err)
@@ -313,22 +513,15 @@ bool eSpeccyHandler::OpenFile(const char* name, const void* data, size_t data_si
 	if(data && data_size)
 		return t->Open(name, data, data_size);
 
-	FILE* f = fopen(name, "rb");
+	xIo::eFileData* f = xIo::eFileData::Open(name);
+#ifdef USE_ZIP
+	if(!f)
+		f = OpenZipMember(name); // "archive.zip/member" path
+#endif//USE_ZIP
 	if(!f)
 		return false;
-	fseek(f, 0, SEEK_END);
-	size_t size = ftell(f);
-	fseek(f, 0, SEEK_SET);
-	byte* buf = new byte[size];
-	size_t r = fread(buf, 1, size, f);
-	fclose(f);
-	if(r != size)
-	{
-		delete[] buf;
-		return false;
-	}
-	bool ok = t->Open(name, buf, size);
-	delete[] buf;
+	bool ok = t->OpenData(name, f);
+	f->Release();
 	return ok;
 }
 bool eSpeccyHandler::OnSaveFile(const char* name)
@@ -347,6 +540,62 @@ static struct eOptionTapeFast : public xOptions::eOptionBool
 	virtual int Order() const { return 50; }
 } op_tape_fast;
 
+static struct eOptionTapeInstant : public xOptions::eOptionBool
+{
+	virtual const char* Name() const { return "instant tape"; }
+	virtual int Order() const { return 51; }
+} op_tape_instant;
+
+static struct eOptionTrDosFast : public xOptions::eOptionBool
+{
+	virtual const char* Name() const { return "fast tr-dos"; }
+	virtual void Change(bool next = true)
+	{
+		eOptionBool::Change();
+		Apply();
+	}
+	virtual void Apply()
+	{
+		sh.speccy->Device<eWD1793>()->FastMode(*this);
+	}
+	virtual int Order() const { return 52; }
+} op_trdos_fast;
+
+// start recording of .rzx from current state (or stop it if name is NULL)
+bool eSpeccyHandler::Record(const char* name)
+{
+	// .szx can't tell TR-DOS rom is paged in, so recording can't start while it is
+	if(name && speccy->Device<eRom>()->DosSelected())
+		return false;
+	Replay(NULL);
+	SAFE_DELETE(recorder);
+	speccy->Device<eWD1793>()->FastMode(op_trdos_fast);
+	if(!name)
+		return true;
+	// traps changing memory/registers directly can't be replayed
+	speccy->Device<eWD1793>()->FastMode(false);
+	speccy->CPU()->HandlerStep(NULL);
+	byte* snapshot = new byte[xSnapshot::SZX_SIZE_MAX];
+	size_t size = xSnapshot::StoreSZX(speccy, snapshot);
+	recorder = new eRZXRecord;
+	bool ok = size && recorder->Open(name, snapshot, size, "szx");
+	SAFE_DELETE_ARRAY(snapshot);
+	if(!ok)
+	{
+		SAFE_DELETE(recorder);
+		return false;
+	}
+	speccy->CPU()->HandlerIo(this);
+	return true;
+}
+
+// off by default, as original image file is rewritten (whole one for scl/fdi)
+static struct eOptionDiskWriteBack : public xOptions::eOptionBool
+{
+	virtual const char* Name() const { return "save disk changes"; }
+	virtual int Order() const { return 53; }
+} op_disk_write_back;
+
 static struct eOptionAutoPlayImage : public xOptions::eOptionBool
 {
 	eOptionAutoPlayImage() { Set(true); }
@@ -354,6 +603,68 @@ static struct eOptionAutoPlayImage : public xOptions::eOptionBool
 	virtual int Order() const { return 55; }
 } op_auto_play_image;
 
+static struct eOptionFastForward : public xOptions::eOptionBool
+{
+	eOptionFastForward() { storeable = false; }
+	virtual const char* Name() const { return "fast forward"; }
+	virtual int Order() const { return 56; }
+} op_fast_forward;
+
+static struct eOptionFastForwardSpeed : public xOptions::eOptionInt
+{
+	eOptionFastForwardSpeed() { Set(FS_10); }
+	enum eSpeed { FS_FIRST, FS_5 = FS_FIRST, FS_10, FS_20, FS_LAST };
+	virtual const char* Name() const { return "fast forward speed"; }
+	virtual const char** Values() const
+	{
+		static const char* values[] = { "x5", "x10", "x20", NULL };
+		return values;
+	}
+	virtual void Change(bool next = true) { eOptionInt::Change(FS_FIRST, FS_LAST, next); }
+	virtual int Order() const { return 57; }
+} op_fast_forward_speed;
+
+static struct eOptionRenderThread : public xOptions::eOptionBool
+{
+	virtual const char* Name() const { return "render thread"; }
+	virtual void Change(bool next = true)
+	{
+		eOptionBool::Change();
+		Apply();
+	}
+	virtual void Apply()
+	{
+		sh.speccy->Device<eUla>()->Threaded(*this);
+	}
+	virtual int Order() const { return 58; }
+} op_render_thread;
+
+static struct eOptionSoundThread : public xOptions::eOptionBool
+{
+	virtual const char* Name() const { return "sound thread"; }
+	virtual void Change(bool next = true)
+	{
+		eOptionBool::Change();
+		Apply();
+	}
+	virtual void Apply()
+	{
+		sh.speccy->Device<eAY>()->Threaded(*this);
+	}
+	virtual int Order() const { return 59; }
+} op_sound_thread;
+
+static int FastForwardFrames()
+{
+	static const int frames[] = { 5, 10, 20 };
+	return frames[op_fast_forward_speed];
+}
+// fast forward while key is held or tape loads in fast mode
+bool eSpeccyHandler::FullSpeed() const
+{
+	return op_fast_forward || speccy->CPU()->HandlerStep() != NULL;
+}
+
 static struct eOption48K : public xOptions::eOptionBool
 {
 	virtual const char* Name() const { return "mode 48k"; }
@@ -369,6 +680,22 @@ static struct eOption48K : public xOptions::eOptionBool
 	virtual int Order() const { return 65; }
 } op_48k;
 
+static struct eOptionBetaDisk : public xOptions::eOptionBool
+{
+	eOptionBetaDisk() { Set(true); }
+	virtual const char* Name() const { return "beta disk"; }
+	virtual void Change(bool next = true)
+	{
+		eOptionBool::Change();
+		Apply();
+	}
+	virtual void Apply()
+	{
+		sh.OnAction(A_RESET);
+	}
+	virtual int Order() const { return 66; }
+} op_beta_disk;
+
 static struct eOptionResetToServiceRom : public xOptions::eOptionBool
 {
 #ifdef GCWZERO
@@ -379,6 +706,43 @@ static struct eOptionResetToServiceRom : public xOptions::eOptionBool
 	virtual int Order() const { return 79; }
 } op_reset_to_service_rom;
 
+static struct eOptionRecordRZX : public xOptions::eOptionBool
+{
+	eOptionRecordRZX() { storeable = false; }
+	virtual const char* Name() const { return "rzx record"; }
+	virtual const char* Value() const { return Values()[sh.recorder ? 1 : 0]; }
+	virtual void Change(bool next = true)
+	{
+		if(sh.recorder)
+		{
+			sh.Record(NULL);
+			return;
+		}
+		// "folder/game.tap" -> "folder/game.rzx", archive used instead of zip member
+		char name[xIo::MAX_PATH_LEN];
+		strcpy(name, OpLastFile());
+#ifdef USE_ZIP
+		const char* member = NULL;
+		char archive[xIo::MAX_PATH_LEN];
+		if(eZipDir::SplitPath(name, archive, &member))
+			strcpy(name, archive);
+#endif//USE_ZIP
+		char* e = name + strlen(name);
+		while(e > name && *e != '.' && *e != '\\' && *e != '/')
+			--e;
+		if(*e != '.')
+		{
+			strcpy(name, OpLastFolder());
+			e = name + strlen(name);
+			strcpy(e, "record");
+			e += strlen(e);
+		}
+		strcpy(e, ".rzx");
+		sh.Record(name);
+	}
+	virtual int Order() const { return 45; }
+} op_record_rzx;
+
 #ifdef GCWZERO
 static struct eOptionFullscreen : public xOptions::eOptionBool
 {
@@ -402,9 +766,13 @@ eActionResult eSpeccyHandler::OnAction(eAction action)
 	{
 	case A_RESET:
 		if(!inside_replay_update) // can be called from replay->Update()
+		{
 			SAFE_DELETE(replay);
+			Record(NULL);
+		}
 		SAFE_DELETE(macro);
 		speccy->Mode48k(op_48k);
+		speccy->BetaDisk(op_beta_disk);
 		speccy->Reset();
 		if(!speccy->Mode48k())
 			speccy->Device<eRom>()->SelectPage(op_reset_to_service_rom ? eRom::ROM_SYS : eRom::ROM_128_1);
@@ -418,11 +786,11 @@ eActionResult eSpeccyHandler::OnAction(eAction action)
 				return AR_TAPE_NOT_INSERTED;
 			if(!tape->Started())
 			{
-				if(op_tape_fast)
-					speccy->CPU()->HandlerStep(fast_tape_emul);
-				else
-					speccy->CPU()->HandlerStep(NULL);
+				bool fast = !recorder && (op_tape_fast || op_tape_instant);
+				speccy->CPU()->HandlerStep(fast ? fast_tape_emul : NULL);
+				tape->Instant(!recorder && op_tape_instant);
 				tape->Start();
+
 			}
 			else
 				tape->Stop();
@@ -508,9 +876,16 @@ void SetupSoundChip()
 static struct eFileTypeRZX : public eFileType
 {
 	virtual bool Open(const char *name, const void* data, size_t data_size)
+	{
+		xIo::eFileData* f = xIo::eFileData::Copy(data, data_size);
+		bool ok = OpenData(name, f);
+		f->Release();
+		return ok;
+	}
+	virtual bool OpenData(const char *name, xIo::eFileData* file)
 	{
 		eRZX* rzx = new eRZX;
-		if(rzx->Open(data, data_size, &sh) == eRZX::E_OK)
+		if(rzx->Open(file, &sh) == eRZX::E_OK)
 		{
 			sh.Replay(rzx);
 			return true;
@@ -522,6 +897,7 @@ static struct eFileTypeRZX : public eFileType
 		}
 		return false;
 	}
+	virtual bool Store(const char* name) { return sh.Record(name); }
 	virtual const char* Type() { return "rzx"; }
 } ft_rzx;
 
@@ -570,13 +946,42 @@ class eMacroDiskRun : public eMacro
 	}
 };
 
+static struct eDiskImages
+{
+	enum { DRIVES = D_LAST };
+	eDiskImages() { memset(type, 0, sizeof(type)); memset(idle, 0, sizeof(idle)); }
+	// type is NULL for images unable to be written back (e.g. from zip)
+	void Bind(int drive, const char* _name, const char* _type)
+	{
+		strncpy(name[drive], _name, xIo::MAX_PATH_LEN - 1);
+		name[drive][xIo::MAX_PATH_LEN - 1] = '\0';
+		type[drive] = _type;
+		idle[drive] = 0;
+	}
+	char name[DRIVES][xIo::MAX_PATH_LEN];
+	const char* type[DRIVES];
+	int idle[DRIVES];
+} disk_images;
+
 static struct eFileTypeTRD : public eFileType
 {
 	virtual bool Open(const char *name, const void* data, size_t data_size)
 	{
 		eWD1793* wd = sh.speccy->Device<eWD1793>();
 		bool ok = wd->Open(Type(), OpDrive(), data, data_size);
-		if(ok && op_auto_play_image)
+		if(ok)
+		{
+			bool own_file = FindByName(name) == this;
+#ifdef USE_ZIP
+			char archive[xIo::MAX_PATH_LEN];
+			const char* member;
+			if(eZipDir::SplitPath(name, archive, &member))
+				own_file = false;
+#endif//USE_ZIP
+			disk_images.Bind(OpDrive(), name, own_file ? Type() : NULL);
+		}
+
+		if(ok && op_auto_play_image && op_beta_disk)
 		{
 			sh.OnAction(A_RESET);
 			if(wd->BootExist(OpDrive()))
@@ -589,6 +994,14 @@ static struct eFileTypeTRD : public eFileType
 		}
 		return ok;
 	}
+	virtual bool Store(const char* name)
+	{
+		xIo::eFileWrite w(name, false);
+		if(!sh.speccy->Device<eWD1793>()->Store(OpDrive(), Type(), &w) || !w.Execute())
+			return false;
+		disk_images.Bind(OpDrive(), name, Type());
+		return true;
+	}
 	virtual const char* Type() { return "trd"; }
 } ft_trd;
 static struct eFileTypeSCL : public eFileTypeTRD
@@ -600,6 +1013,32 @@ static struct eFileTypeFDI : public eFileTypeTRD
 	virtual const char* Type() { return "fdi"; }
 } ft_fdi;
 
+static void DiskWriteBack(bool flush)
+{
+	if(!op_disk_write_back)
+		return;
+	eWD1793* wd = sh.speccy->Device<eWD1793>();
+	for(int i = 0; i < eDiskImages::DRIVES; ++i)
+	{
+		if(!disk_images.type[i] || !wd->Dirty(i))
+			continue;
+		// wait for a second of disk inactivity, so file is written once per save
+		if(wd->Busy())
+			disk_images.idle[i] = 0;
+		else
+			++disk_images.idle[i];
+		if(!flush && disk_images.idle[i] < 50)
+			continue;
+		xIo::eFileWrite* w = new xIo::eFileWrite(disk_images.name[i], !strcmp(disk_images.type[i], "trd"));
+		if(wd->Store(i, disk_images.type[i], w, true) && !w->Empty())
+			xIo::WriteAsync(w);
+		else
+			delete w;
+		disk_images.idle[i] = 0;
+
+	}
+}
+
 class eMacroTapeLoad : public eMacro
 {
 	virtual bool Do()
@@ -638,7 +1077,15 @@ static struct eFileTypeTAP : public eFileType
 {
 	virtual bool Open(const char *name, const void* data, size_t data_size)
 	{
-		bool ok = sh.speccy->Device<eTape>()->Open(Type(), data, data_size);
+		xIo::eFileData* f = xIo::eFileData::Copy(data, data_size);
+		bool ok = OpenData(name, f);
+		f->Release();
+		return ok;
+	}
+	virtual bool OpenData(const char *name, xIo::eFileData* file)
+	{
+		bool ok = sh.speccy->Device<eTape>()->Open(Type(), file);
+
 		if(ok && op_auto_play_image)
 		{
 			sh.OnAction(A_RESET);
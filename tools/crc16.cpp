@@ -0,0 +1,71 @@
+/*
+Portable ZX-Spectrum emulator.
+Copyright (C) 2001-2010 SMT, Dexus, Alone Coder, deathsoft, djdron, scor
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "crc16.h"
+
+namespace xCrc
+{
+
+word crc16_table[8][0x100];
+
+static struct eCrc16Init
+{
+	eCrc16Init()
+	{
+		for(int i = 0; i < 0x100; ++i)
+		{
+			dword crc = i << 8;
+			for(int j = 8; j; --j)
+			{
+				if((crc <<= 1) & 0x10000)
+					crc ^= 0x1021;
+			}
+			crc16_table[0][i] = crc;
+		}
+		// table k: byte followed by k zero bytes (slice-by-8)
+		for(int k = 1; k < 8; ++k)
+		{
+			for(int i = 0; i < 0x100; ++i)
+			{
+				word crc = crc16_table[k - 1][i];
+				crc16_table[k][i] = (crc << 8) ^ crc16_table[0][crc >> 8];
+			}
+		}
+	}
+} crc16_init;
+
+//=============================================================================
+//	Crc16
+//-----------------------------------------------------------------------------
+word Crc16(word crc, const byte* src, size_t size)
+{
+	for(; size >= 8; size -= 8, src += 8)
+	{
+		crc =	crc16_table[7][src[0] ^ (crc >> 8)] ^
+				crc16_table[6][src[1] ^ (crc & 0xff)] ^
+				crc16_table[5][src[2]] ^ crc16_table[4][src[3]] ^
+				crc16_table[3][src[4]] ^ crc16_table[2][src[5]] ^
+				crc16_table[1][src[6]] ^ crc16_table[0][src[7]];
+	}
+	while(size--)
+		crc = Crc16(crc, *src++);
+	return crc;
+}
+
+}
+//namespace xCrc
@@ -0,0 +1,41 @@
+/*
+Portable ZX-Spectrum emulator.
+Copyright (C) 2001-2010 SMT, Dexus, Alone Coder, deathsoft, djdron, scor
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef __CRC16_H__
+#define __CRC16_H__
+
+#include "../std.h"
+
+#pragma once
+
+namespace xCrc
+{
+
+// CRC16-CCITT (x^16+x^12+x^5+1), msb first, as used by WD1793
+extern word crc16_table[8][0x100];
+
+inline word Crc16(word crc, byte v)
+{
+	return (crc << 8) ^ crc16_table[0][(crc >> 8) ^ v];
+}
+word Crc16(word crc, const byte* src, size_t size);
+
+}
+//namespace xCrc
+
+#endif//__CRC16_H__
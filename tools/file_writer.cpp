@@ -0,0 +1,135 @@
+/*
+Portable ZX-Spectrum emulator.
+Copyright (C) 2001-2012 SMT, Dexus, Alone Coder, deathsoft, djdron, scor
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../std.h"
+#include "file_writer.h"
+#include "job_thread.h"
+
+namespace xIo
+{
+
+//=============================================================================
+//	eFileWrite::eFileWrite
+//-----------------------------------------------------------------------------
+eFileWrite::eFileWrite(const char* _name, bool _patch) : patch(_patch)
+{
+	strncpy(name, _name, MAX_PATH_LEN - 1);
+	name[MAX_PATH_LEN - 1] = '\0';
+}
+//=============================================================================
+//	eFileWrite::~eFileWrite
+//-----------------------------------------------------------------------------
+eFileWrite::~eFileWrite()
+{
+	for(size_t i = 0; i < chunks.size(); ++i)
+	{
+		SAFE_DELETE_ARRAY(chunks[i].data);
+	}
+}
+//=============================================================================
+//	eFileWrite::Add
+//-----------------------------------------------------------------------------
+void eFileWrite::Add(size_t offset, const void* data, size_t size)
+{
+	eChunk c;
+	c.offset = offset;
+	c.size = size;
+	c.data = new byte[size];
+	memcpy(c.data, data, size);
+	chunks.push_back(c);
+}
+//=============================================================================
+//	eFileWrite::Execute
+//-----------------------------------------------------------------------------
+bool eFileWrite::Execute() const
+{
+	size_t size = 0;
+	FILE* f = patch ? fopen(name, "rb") : NULL;
+	if(f)
+	{
+		fseek(f, 0, SEEK_END);
+		size = ftell(f);
+		fseek(f, 0, SEEK_SET);
+	}
+	size_t orig_size = size;
+	for(size_t i = 0; i < chunks.size(); ++i)
+	{
+		if(chunks[i].offset + chunks[i].size > size)
+			size = chunks[i].offset + chunks[i].size;
+	}
+	byte* buf = new byte[size];
+	memset(buf, 0, size);
+	bool ok = true;
+	if(f)
+	{
+		ok = fread(buf, 1, orig_size, f) == orig_size;
+		fclose(f);
+	}
+	if(!ok)
+	{
+		delete[] buf;
+		return false;
+	}
+	for(size_t i = 0; i < chunks.size(); ++i)
+	{
+		memcpy(buf + chunks[i].offset, chunks[i].data, chunks[i].size);
+	}
+	char tmp_name[MAX_PATH_LEN + 4];
+	strcpy(tmp_name, name);
+	strcat(tmp_name, ".tmp");
+	f = fopen(tmp_name, "wb");
+	if(f)
+	{
+		ok = fwrite(buf, 1, size, f) == size;
+		ok = fclose(f) == 0 && ok;
+	}
+	else
+		ok = false;
+	delete[] buf;
+	if(ok)
+	{
+#if !defined(_LINUX) && !defined(_POSIX)
+		remove(name); // rename() doesn't replace existing file here
+#endif//!_LINUX && !_POSIX
+		ok = rename(tmp_name, name) == 0;
+	}
+	if(!ok)
+		remove(tmp_name);
+	return ok;
+}
+
+struct eWriteJob : public eJobThread::eJob
+{
+	eWriteJob(eFileWrite* _w) : w(_w) {}
+	virtual void Execute() { w->Execute(); }
+	virtual void Release() { delete w; delete this; }
+	eFileWrite* w;
+};
+static eJobThread write_thread;
+
+//=============================================================================
+//	WriteAsync
+//-----------------------------------------------------------------------------
+void WriteAsync(eFileWrite* w) { write_thread.Push(new eWriteJob(w)); }
+//=============================================================================
+//	WriteWait
+//-----------------------------------------------------------------------------
+void WriteWait() { write_thread.Wait(); }
+
+}
+//namespace xIo
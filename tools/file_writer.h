@@ -0,0 +1,64 @@
+/*
+Portable ZX-Spectrum emulator.
+Copyright (C) 2001-2012 SMT, Dexus, Alone Coder, deathsoft, djdron, scor
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef	__FILE_WRITER_H__
+#define	__FILE_WRITER_H__
+
+#include <vector>
+#include "../platform/io.h"
+
+#pragma once
+
+namespace xIo
+{
+
+//*****************************************************************************
+//	eFileWrite
+//-----------------------------------------------------------------------------
+// set of data chunks to be placed into file, over its current contents
+// in patch mode. result goes to temporary file renamed over original one,
+// so file is never left half written
+//-----------------------------------------------------------------------------
+class eFileWrite
+{
+public:
+	eFileWrite(const char* name, bool patch);
+	~eFileWrite();
+	void Add(size_t offset, const void* data, size_t size);
+	bool Empty() const { return chunks.empty(); }
+	bool Execute() const;
+
+protected:
+	struct eChunk
+	{
+		size_t	offset;
+		size_t	size;
+		byte*	data;
+	};
+	char	name[MAX_PATH_LEN];
+	bool	patch;
+	std::vector<eChunk> chunks;
+};
+
+void WriteAsync(eFileWrite* w); // takes ownership, executed in background thread if available
+void WriteWait();
+
+}
+//namespace xIo
+
+#endif//__FILE_WRITER_H__
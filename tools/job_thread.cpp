@@ -0,0 +1,192 @@
+/*
+Portable ZX-Spectrum emulator.
+Copyright (C) 2001-2012 SMT, Dexus, Alone Coder, deathsoft, djdron, scor
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "../std.h"
+#include "job_thread.h"
+
+#if defined(_LINUX) || defined(_POSIX)
+#define USE_JOB_THREAD
+#include <pthread.h>
+#include <list>
+#endif//_LINUX || _POSIX
+
+#ifdef USE_JOB_THREAD
+
+struct eJobThread::eData
+{
+	static void* Run(void* _d);
+	bool Create();
+	pthread_t thread;
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+	bool created;
+	bool started;
+	bool stop;
+	eJob* job; // in progress
+	std::list<eJob*> jobs;
+};
+
+//=============================================================================
+//	eJobThread::eJobThread
+//-----------------------------------------------------------------------------
+eJobThread::eJobThread()
+{
+	data = new eData;
+	pthread_mutex_init(&data->mutex, NULL);
+	pthread_cond_init(&data->cond, NULL);
+	data->created = data->started = false;
+	data->stop = false;
+	data->job = NULL;
+}
+//=============================================================================
+//	eJobThread::~eJobThread
+//-----------------------------------------------------------------------------
+eJobThread::~eJobThread()
+{
+	if(data->started)
+	{
+		pthread_mutex_lock(&data->mutex);
+		while(data->job || !data->jobs.empty())
+			pthread_cond_wait(&data->cond, &data->mutex);
+		data->stop = true;
+		pthread_cond_broadcast(&data->cond);
+		pthread_mutex_unlock(&data->mutex);
+		pthread_join(data->thread, NULL);
+	}
+	pthread_cond_destroy(&data->cond);
+	pthread_mutex_destroy(&data->mutex);
+	delete data;
+}
+//=============================================================================
+//	eJobThread::eData::Create
+//-----------------------------------------------------------------------------
+// false if unable to run in background
+bool eJobThread::eData::Create()
+{
+	if(!created)
+	{
+		created = true;
+		started = pthread_create(&thread, NULL, Run, this) == 0;
+	}
+	return started;
+}
+//=============================================================================
+//	eJobThread::Start
+//-----------------------------------------------------------------------------
+void eJobThread::Start(eJob* job)
+{
+	if(!data->Create())
+	{
+		job->Execute();
+		job->Release();
+		return;
+	}
+	pthread_mutex_lock(&data->mutex);
+	while(data->job || !data->jobs.empty())
+		pthread_cond_wait(&data->cond, &data->mutex);
+	data->jobs.push_back(job);
+	pthread_cond_broadcast(&data->cond);
+	pthread_mutex_unlock(&data->mutex);
+}
+//=============================================================================
+//	eJobThread::Push
+//-----------------------------------------------------------------------------
+void eJobThread::Push(eJob* job)
+{
+	if(!data->Create())
+	{
+		job->Execute();
+		job->Release();
+		return;
+	}
+	pthread_mutex_lock(&data->mutex);
+	data->jobs.push_back(job);
+	pthread_cond_broadcast(&data->cond);
+	pthread_mutex_unlock(&data->mutex);
+}
+//=============================================================================
+//	eJobThread::Wait
+//-----------------------------------------------------------------------------
+void eJobThread::Wait()
+{
+	if(!data->started)
+		return;
+	pthread_mutex_lock(&data->mutex);
+	while(data->job || !data->jobs.empty())
+		pthread_cond_wait(&data->cond, &data->mutex);
+	pthread_mutex_unlock(&data->mutex);
+}
+//=============================================================================
+//	eJobThread::Busy
+//-----------------------------------------------------------------------------
+bool eJobThread::Busy() const
+{
+	if(!data->started)
+		return false;
+	pthread_mutex_lock(&data->mutex);
+	bool busy = data->job || !data->jobs.empty();
+	pthread_mutex_unlock(&data->mutex);
+	return busy;
+}
+//=============================================================================
+//	eJobThread::Lock
+//-----------------------------------------------------------------------------
+void eJobThread::Lock() { pthread_mutex_lock(&data->mutex); }
+//=============================================================================
+//	eJobThread::Unlock
+//-----------------------------------------------------------------------------
+void eJobThread::Unlock() { pthread_mutex_unlock(&data->mutex); }
+//=============================================================================
+//	eJobThread::eData::Run
+//-----------------------------------------------------------------------------
+void* eJobThread::eData::Run(void* _d)
+{
+	eData* d = (eData*)_d;
+	pthread_mutex_lock(&d->mutex);
+	for(;;)
+	{
+		while(d->jobs.empty() && !d->stop)
+			pthread_cond_wait(&d->cond, &d->mutex);
+		if(d->jobs.empty())
+			break;
+		d->job = d->jobs.front();
+		d->jobs.pop_front();
+		pthread_mutex_unlock(&d->mutex);
+		d->job->Execute();
+		d->job->Release();
+		pthread_mutex_lock(&d->mutex);
+		d->job = NULL;
+		pthread_cond_broadcast(&d->cond);
+	}
+	pthread_mutex_unlock(&d->mutex);
+	return NULL;
+}
+
+#else//USE_JOB_THREAD
+
+eJobThread::eJobThread() : data(NULL) {}
+eJobThread::~eJobThread() {}
+void eJobThread::Start(eJob* job) { job->Execute(); job->Release(); }
+void eJobThread::Push(eJob* job) { job->Execute(); job->Release(); }
+void eJobThread::Wait() {}
+bool eJobThread::Busy() const { return false; }
+void eJobThread::Lock() {}
+void eJobThread::Unlock() {}
+
+#endif//USE_JOB_THREAD
@@ -0,0 +1,57 @@
+/*
+Portable ZX-Spectrum emulator.
+Copyright (C) 2001-2012 SMT, Dexus, Alone Coder, deathsoft, djdron, scor
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef	__JOB_THREAD_H__
+#define	__JOB_THREAD_H__
+
+#pragma once
+
+//*****************************************************************************
+//	eJobThread
+//-----------------------------------------------------------------------------
+// runs jobs one by one in background thread (started on first job), so
+// emulation can go on with the next frame meanwhile. where no threads are
+// available (or thread can't be started) job is executed right away
+//-----------------------------------------------------------------------------
+class eJobThread
+{
+public:
+	class eJob
+	{
+	public:
+		virtual ~eJob() {}
+		virtual void Execute() = 0;
+		virtual void Release() {} // job is over, it may delete itself here
+	};
+	eJobThread();
+	~eJobThread(); // finishes all queued jobs
+	void Start(eJob* job); // waits for previous jobs before
+	void Push(eJob* job); // queued after previous jobs without waiting
+	void Wait();
+	bool Busy() const; // job is in progress or queued
+	// guards data shared by jobs with their owners, mustn't be held on calls above
+	void Lock();
+	void Unlock();
+
+protected:
+	struct eData;
+	eData*	data;
+};
+
+#endif//__JOB_THREAD_H__
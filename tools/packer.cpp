@@ -0,0 +1,133 @@
+/*
+Portable ZX-Spectrum emulator.
+Copyright (C) 2001-2012 SMT, Dexus, Alone Coder, deathsoft, djdron, scor
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../std.h"
+#include "packer.h"
+
+#ifdef USE_ZIP
+
+namespace xIo
+{
+
+//=============================================================================
+//	ePacker::ePacker
+//-----------------------------------------------------------------------------
+ePacker::ePacker() : active(false)
+{
+	for(int i = 0; i < 2; ++i)
+	{
+		jobs[i].packer = this;
+		jobs[i].i = i;
+	}
+}
+//=============================================================================
+//	ePacker::~ePacker
+//-----------------------------------------------------------------------------
+ePacker::~ePacker()
+{
+	Finish();
+}
+//=============================================================================
+//	ePacker::Start
+//-----------------------------------------------------------------------------
+bool ePacker::Start(FILE* f, int level, bool gzip)
+{
+	Finish();
+	memset(&zs, 0, sizeof(zs));
+	if(deflateInit2(&zs, level, Z_DEFLATED, gzip ? 15 + 16 : 15, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+		return false;
+	file = f;
+	active = true;
+	failed = false;
+	cur = 0;
+	pos = 0;
+	return true;
+}
+//=============================================================================
+//	ePacker::Finish
+//-----------------------------------------------------------------------------
+bool ePacker::Finish()
+{
+	if(!active)
+		return false;
+	Next(true);
+	thread.Wait();
+	deflateEnd(&zs);
+	active = false;
+	return !failed;
+}
+//=============================================================================
+//	ePacker::Pack
+//-----------------------------------------------------------------------------
+// deflate filled chunk into file, called by job thread or by writer itself
+void ePacker::Pack(int i)
+{
+	zs.next_in = chunk[i];
+	zs.avail_in = chunk_size[i];
+	int flush = last[i] ? Z_FINISH : Z_NO_FLUSH;
+	do
+	{
+		zs.next_out = out;
+		zs.avail_out = CHUNK_SIZE;
+		if(deflate(&zs, flush) == Z_STREAM_ERROR)
+		{
+			failed = true;
+			break;
+		}
+		size_t size = CHUNK_SIZE - zs.avail_out;
+		if(fwrite(out, 1, size, file) != size)
+			failed = true;
+	}
+	while(!zs.avail_out);
+}
+//=============================================================================
+//	ePacker::Next
+//-----------------------------------------------------------------------------
+// current chunk filled, switch to the other one
+void ePacker::Next(bool _last)
+{
+	chunk_size[cur] = pos;
+	last[cur] = _last;
+	pos = 0;
+	// packing of the other chunk is over once this one is started
+	thread.Start(&jobs[cur]);
+	cur ^= 1;
+}
+//=============================================================================
+//	ePacker::Write
+//-----------------------------------------------------------------------------
+void ePacker::Write(const byte* src, size_t size)
+{
+	while(size)
+	{
+		size_t s = CHUNK_SIZE - pos;
+		if(s > size)
+			s = size;
+		memcpy(chunk[cur] + pos, src, s);
+		pos += s;
+		src += s;
+		size -= s;
+		if(pos == CHUNK_SIZE)
+			Next(false);
+	}
+}
+
+}
+//namespace xIo
+
+#endif//USE_ZIP
@@ -0,0 +1,80 @@
+/*
+Portable ZX-Spectrum emulator.
+Copyright (C) 2001-2012 SMT, Dexus, Alone Coder, deathsoft, djdron, scor
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef	__PACKER_H__
+#define	__PACKER_H__
+
+#include "../platform/platform.h"
+#include "job_thread.h"
+
+#pragma once
+
+#ifdef USE_ZIP
+
+#include <zlib.h>
+
+namespace xIo
+{
+
+//*****************************************************************************
+//	ePacker
+//-----------------------------------------------------------------------------
+// deflates data being written into file from two chunks in turn (in job
+// thread where available), so storing of data is plain copy to memory. the
+// only wait is when the whole chunk is filled
+//-----------------------------------------------------------------------------
+class ePacker
+{
+public:
+	ePacker();
+	~ePacker();
+	// zlib stream, or gzip one readable by gzread()/zcat
+	bool Start(FILE* f, int level = Z_DEFAULT_COMPRESSION, bool gzip = false);
+	bool Finish(); // packs the rest of data, false if anything failed
+	void Write(const byte* src, size_t size);
+
+private:
+	void Next(bool last);
+	void Pack(int i);
+	struct ePackJob : public eJobThread::eJob
+	{
+		virtual void Execute() { packer->Pack(i); }
+		ePacker* packer;
+		int i;
+	};
+	enum { CHUNK_SIZE = 32768 };
+	z_stream zs;
+	FILE* file;
+	byte chunk[2][CHUNK_SIZE];
+	byte out[CHUNK_SIZE];
+	size_t chunk_size[2];
+	bool last[2];		// chunk ends the stream
+	bool failed;
+	bool active;
+	int cur;
+	size_t pos;
+	ePackJob jobs[2];
+	eJobThread thread;	// started on first pack
+};
+
+}
+//namespace xIo
+
+#endif//USE_ZIP
+
+#endif//__PACKER_H__
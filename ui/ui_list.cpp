@@ -41,6 +41,32 @@ void eList::Insert(const char* item)
 		Selected(0);
 }
 //=============================================================================
+//	eList::Insert
+//-----------------------------------------------------------------------------
+void eList::Insert(const char* item, int pos)
+{
+	if(pos >= MAX_ITEMS)
+		return;
+	if(size == MAX_ITEMS)
+	{
+		--size;
+		delete[] items[size];
+		items[size] = NULL;
+		if(selected >= size)
+			selected = size - 1;
+	}
+	char* s = new char[strlen(item) + 1];
+	strcpy(s, item);
+	memmove(items + pos + 1, items + pos, (size - pos + 1)*sizeof(const char*));
+	items[pos] = s;
+	++size;
+	changed = true;
+	if(Selected() < 0)
+		Selected(0);
+	else if(pos <= selected)
+		++selected;
+}
+//=============================================================================
 //	eList::Clear
 //-----------------------------------------------------------------------------
 void eList::Clear()
@@ -30,13 +30,14 @@ namespace xUi
 
 class eList : public eControl
 {
-	enum { MAX_ITEMS = 2000 };
+	enum { MAX_ITEMS = 10000 };
 	enum eNotify { N_SELECTED };
 public:
 	eList() : size(0), last_selected(-1), selected(-1), page_begin(0), page_size(0) { items[0] = NULL; }
 	virtual ~eList() { Clear(); }
 	void Clear();
 	void Insert(const char* item);
+	void Insert(const char* item, int pos); // keeps selected item, last one is dropped if full
 	const char* Item() const { return selected >= 0 ? items[selected] : NULL; }
 	void Item(const char* item);
 	const char** Items() { return items; }
@@ -32,26 +32,12 @@ namespace xZ80
 eZ80::eZ80(eMemory* _m, eDevices* _d, dword _frame_tacts)
 	: memory(_m), rom(_d->Get<eRom>()), ula(_d->Get<eUla>()), devices(_d)
 	, t(0), im(0), eipos(0)
-	, frame_tacts(_frame_tacts), fetches(0), reg_unused(0)
+	, frame_tacts(_frame_tacts), fetches(0), t_limit(0)
+	, paging(false), paging_jump(-1), reg_unused(0)
 {
 	pc = sp = ir = memptr = ix = iy = 0;
 	bc = de = hl = af = alt.bc = alt.de = alt.hl = alt.af = 0;
 	int_flags = 0;
-
-	InitOpNoPrefix();
-	InitOpCB();
-	InitOpDD();
-	InitOpED();
-	InitOpFD();
-	InitOpDDCB();
-
-	// offsets to b,c,d,e,h,l,<unused>,a  from cpu.c
-	const REGP r_offset[] =
-	{
-		&eZ80::b, &eZ80::c, &eZ80::d, &eZ80::e,
-		&eZ80::h, &eZ80::l, &eZ80::reg_unused, &eZ80::a
-	};
-	memcpy(reg_offset, r_offset, sizeof(r_offset));
 }
 //=============================================================================
 //	eZ80::Reset
@@ -73,54 +59,131 @@ inline byte eZ80::Read(word addr) const
 	return memory->Read(addr);
 }
 //=============================================================================
-//	eZ80::StepF
+//	eZ80::RomSos
 //-----------------------------------------------------------------------------
-void eZ80::StepF()
+template<class M> inline int eZ80::RomSos() const
 {
-	rom->Read(pc);
-	SAFE_CALL(handler.step)->Z80_Step(this);
-	(this->*normal_opcodes[Fetch()])();
+	if(M::MODE_48K < 0)
+		return rom->ROM_SOS();
+	return M::MODE_48K > 0 ? eRom::ROM_48 : eRom::ROM_128_0;
+}
+//=============================================================================
+//	eZ80::Paging
+//-----------------------------------------------------------------------------
+template<class M> inline void eZ80::Paging()
+{
+	if(M::TRDOS)
+		rom->Read(pc, RomSos<M>());
+}
+//=============================================================================
+//	eZ80::PagingJump
+//-----------------------------------------------------------------------------
+template<class M> inline int eZ80::PagingJump() const
+{
+	if(rom->DosSelected())
+		return 0;
+	if(rom->Page() != RomSos<M>())
+		return -1;
+	return (pc_h & 0xc0) ? 1 : 0;
 }
 //=============================================================================
 //	eZ80::Step
 //-----------------------------------------------------------------------------
-void eZ80::Step()
+template<class M> inline void eZ80::Step()
 {
-	rom->Read(pc);
+	if(M::TRACE)
+		handler.trace->Z80_Trace(this, false);
 	(this->*normal_opcodes[Fetch()])();
 }
 //=============================================================================
+//	eZ80::StepP
+//-----------------------------------------------------------------------------
+template<class M> inline void eZ80::StepP()
+{
+	Paging<M>();
+	Step<M>();
+}
+//=============================================================================
+//	eZ80::StepF
+//-----------------------------------------------------------------------------
+template<class M> void eZ80::StepF()
+{
+	Paging<M>();
+	SAFE_CALL(handler.step)->Z80_Step(this);
+	Step<M>();
+}
+//=============================================================================
 //	eZ80::Update
 //-----------------------------------------------------------------------------
-void eZ80::Update(int int_len, int* nmi_pending)
+template<class M> void eZ80::Update(int int_len, int* nmi_pending)
 {
+	if(!M::TRACE && handler.trace)
+	{
+		Update<typename M::Traced>(int_len, nmi_pending);
+		return;
+	}
 	if(!iff1 && halted)
+	{
+		FrameFetches();
 		return;
+	}
 	// INT check separated from main Z80 loop to improve emulation speed
+	bool int_ready = false;
 	while(t < int_len)
 	{
 		if(iff1 && t != eipos) // int enabled in CPU not issued after EI
 		{
-			Int();
+			int_ready = true;
 			break;
 		}
-		Step();
+		StepP<M>();
 		if(halted)
 			break;
 	}
+	// .rzx frame ends with int, so with int missed after EI it lasts till next one
+	if(int_ready || !iff1)
+		FrameFetches();
+	if(int_ready)
+		Int();
 	eipos = -1;
 	if(handler.step)
 	{
 		while(t < frame_tacts)
 		{
-			StepF();
+			StepF<M>();
 		}
 	}
+	else if(M::TRDOS)
+	{
+		// paging is checked before each opcode only while tr-dos or basic rom
+		// executes, as sequential pc advance may open or close tr-dos there.
+		// elsewhere tr-dos may be reached by control transfer only, which
+		// leaves the loop (pc wrap from #ffff to basic rom isn't handled)
+		paging = true;
+		while(t < frame_tacts)
+		{
+			Paging<M>();
+			t_limit = frame_tacts;
+			paging_jump = PagingJump<M>();
+			if(paging_jump == 0)
+			{
+				while(t < t_limit)
+					StepP<M>();
+			}
+			else
+			{
+				while(t < t_limit)
+					Step<M>();
+			}
+		}
+		paging = false;
+		paging_jump = -1;
+	}
 	else
 	{
 		while(t < frame_tacts)
 		{
-			Step();
+			Step<M>();
 //			if(*nmi_pending)
 //			{
 //				--*nmi_pending;
@@ -138,24 +201,40 @@ void eZ80::Update(int int_len, int* nmi_pending)
 //=============================================================================
 //	eZ80::Replay
 //-----------------------------------------------------------------------------
-void eZ80::Replay(int _fetches)
+template<class M> void eZ80::Replay(int _fetches)
 {
+	if(!M::TRACE && handler.trace)
+	{
+		Replay<typename M::Traced>(_fetches);
+		return;
+	}
 	fetches = _fetches;
 	t = 0;
 	eipos = -1;
 	while(fetches > 0)
 	{
-		Step();
+		StepP<M>();
 	}
 	if(iff1)
 		Int();
 	fetches = 0;
 }
+
+template void eZ80::Update<eModelGeneric>(int int_len, int* nmi_pending);
+template void eZ80::Update<eModel48k>(int int_len, int* nmi_pending);
+template void eZ80::Update<eModel128k>(int int_len, int* nmi_pending);
+template void eZ80::Update<eModelPentagon>(int int_len, int* nmi_pending);
+template void eZ80::Replay<eModelGeneric>(int fetches);
+template void eZ80::Replay<eModel48k>(int fetches);
+template void eZ80::Replay<eModel128k>(int fetches);
+template void eZ80::Replay<eModelPentagon>(int fetches);
+
 //=============================================================================
 //	eZ80::Int
 //-----------------------------------------------------------------------------
 void eZ80::Int()
 {
+	SAFE_CALL(handler.trace)->Z80_Trace(this, true);
 	byte vector = 0xff;
 	word intad = 0x38;
 	if(im >= 2) // im2
@@ -60,6 +60,21 @@ union\
 };
 #endif//USE_BIG_ENDIAN
 
+//*****************************************************************************
+//	eModel...
+//-----------------------------------------------------------------------------
+// machine models cpu loop is instantiated for, so checks model doesn't need
+// are compiled out of it. TRDOS - rom paging checked before each opcode,
+// MODE_48K - basic rom tr-dos returns to (-1 - known at runtime only),
+// TRACE - trace handler called before each opcode, Traced - same model
+// with TRACE set (loop switches to it while trace handler is installed)
+//-----------------------------------------------------------------------------
+template<class M> struct eModelTrace : public M { enum { TRACE = 1 }; typedef eModelTrace Traced; };
+struct eModelGeneric	{ enum { TRDOS = 1, MODE_48K = -1, TRACE = 0 }; typedef eModelTrace<eModelGeneric> Traced; };
+struct eModel48k		{ enum { TRDOS = 0, MODE_48K = 1, TRACE = 0 }; typedef eModelTrace<eModel48k> Traced; };
+struct eModel128k		{ enum { TRDOS = 0, MODE_48K = 0, TRACE = 0 }; typedef eModelTrace<eModel128k> Traced; };
+struct eModelPentagon	{ enum { TRDOS = 1, MODE_48K = 0, TRACE = 0 }; typedef eModelTrace<eModelPentagon> Traced; };
+
 enum eFlags
 {
 	CF = 0x01,
@@ -80,8 +95,8 @@ class eZ80
 public:
 	eZ80(eMemory* m, eDevices* d, dword frame_tacts = 0);
 	void Reset();
-	void Update(int int_len, int* nmi_pending);
-	void Replay(int fetches);
+	template<class M> void Update(int int_len, int* nmi_pending);
+	template<class M> void Replay(int fetches);
 
 	dword FrameTacts() const { return frame_tacts; }
 	dword T() const { return t; }
@@ -90,8 +105,11 @@ public:
 	{
 	public:
 		virtual byte Z80_IoRead(word port, int tact) = 0;
+		// frame boundary (point of int check) while not in replay,
+		// fetches - opcode fetches made since previous one
+		virtual void Z80_Frame(int fetches) = 0;
 	};
-	void HandlerIo(eHandlerIo* h) { handler.io = h; }
+	void HandlerIo(eHandlerIo* h) { handler.io = h; fetches = 0; } // fetches are counted from here
 	eHandlerIo* HandlerIo() const { return handler.io; }
 
 	class eHandlerStep
@@ -102,11 +120,28 @@ public:
 	void HandlerStep(eHandlerStep* h) { handler.step = h; }
 	eHandlerStep* HandlerStep() const { return handler.step; }
 
+	class eHandlerTrace
+	{
+	public:
+		// before each opcode executed (int_taken - before int accepted)
+		virtual void Z80_Trace(eZ80* z80, bool int_taken) = 0;
+		virtual void Z80_TraceIo(word port, byte v, int tact, bool write) = 0;
+	};
+	void HandlerTrace(eHandlerTrace* h) { handler.trace = h; }
+	eHandlerTrace* HandlerTrace() const { return handler.trace; }
+
 protected:
 	void Int();
 	void Nmi();
-	void Step();
-	void StepF();
+	template<class M> int RomSos() const;
+	template<class M> void Paging();
+	template<class M> int PagingJump() const;
+	// pc set by control transfer, frame loop is left to check tr-dos paging
+	// when pc goes into (or out of) rom area it was watched for
+	void Jumped() { if(((pc_h & 0xc0) ? 0 : 1) == paging_jump) t_limit = t; } // 1 if pc is in rom area now
+	template<class M> void Step();
+	template<class M> void StepP();
+	template<class M> void StepF();
 	byte Fetch()
 	{
 		--fetches;
@@ -114,6 +149,12 @@ protected:
 		t += 4;
 		return Read(pc++);
 	}
+	void FrameFetches()
+	{
+		if(handler.io)
+			handler.io->Z80_Frame(-fetches);
+		fetches = 0;
+	}
 	byte IoRead(word port) const;
 	void IoWrite(word port, byte v);
 	byte Read(word addr) const;
@@ -121,6 +162,7 @@ protected:
 
 	typedef void (eZ80::*CALLFUNC)();
 	typedef byte (eZ80::*CALLFUNCI)(byte);
+	typedef byte (eZ80::*REGP);
 
 	#include "z80_op.h"
 	#include "z80_op_noprefix.h"
@@ -130,13 +172,6 @@ protected:
 	#include "z80_op_fd.h"
 	#include "z80_op_ddcb.h"
 
-	void InitOpNoPrefix();
-	void InitOpCB();
-	void InitOpDD();
-	void InitOpED();
-	void InitOpFD();
-	void InitOpDDCB();
-
 protected:
 	eMemory*	memory;
 	eRom*		rom;
@@ -145,9 +180,10 @@ protected:
 
 	struct eHandler
 	{
-		eHandler() : io(NULL), step(NULL) {}
+		eHandler() : io(NULL), step(NULL), trace(NULL) {}
 		eHandlerIo*	io;
 		eHandlerStep* step;
+		eHandlerTrace* trace;
 	};
 	eHandler handler;
 
@@ -155,7 +191,10 @@ protected:
 	int		im;
 	int		eipos;
 	int		frame_tacts; 	// t-states per frame
-	int		fetches;		// .rzx replay fetches
+	int		fetches;		// .rzx replay fetches left, negated fetches made otherwise
+	int		t_limit;		// frame loop runs till, lowered to leave it early
+	bool	paging;			// frame loop checks tr-dos paging not before each opcode
+	int		paging_jump;	// jumps to rom area (1), out of it (0) or none (-1) leave frame loop
 
 	DECLARE_REG16(pc, pc_l, pc_h)
 	DECLARE_REG16(sp, sp_l, sp_h)
@@ -187,15 +226,14 @@ protected:
 		DECLARE_REG16(af, f, a)
 	} alt;
 
-	CALLFUNC normal_opcodes[0x100];
-	CALLFUNC logic_opcodes[0x100];
-	CALLFUNC ix_opcodes[0x100];
-	CALLFUNC iy_opcodes[0x100];
-	CALLFUNC ext_opcodes[0x100];
-	CALLFUNCI logic_ix_opcodes[0x100];
-
-	typedef byte (eZ80::*REGP);
-	REGP reg_offset[8];
+	// opcode tables are shared between instances
+	static const CALLFUNC normal_opcodes[0x100];
+	static const CALLFUNC logic_opcodes[0x100];
+	static const CALLFUNC ix_opcodes[0x100];
+	static const CALLFUNC iy_opcodes[0x100];
+	static const CALLFUNC ext_opcodes[0x100];
+	static const CALLFUNCI logic_ix_opcodes[0x100];
+	static const REGP reg_offset[8];
 	byte reg_unused;
 };
 
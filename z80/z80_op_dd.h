@@ -371,6 +371,7 @@ void OpxE5() { // push ix
 }
 void OpxE9() { // jp (ix)
 	pc = ix;
+	Jumped();
 }
 void OpxF9() { // ld sp,ix
 	sp = ix;
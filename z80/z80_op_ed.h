@@ -64,6 +64,7 @@ void Ope45() { // retn
 	unsigned addr = Read(sp++);
 	addr += 0x100*Read(sp++);
 	pc = addr;
+	Jumped();
 	memptr = addr;
 	t += 6;
 }
@@ -111,6 +112,7 @@ void Ope4D() { // reti
 	unsigned addr = Read(sp++);
 	addr += 0x100*Read(sp++);
 	pc = addr;
+	Jumped();
 	memptr = addr;
 	t += 6;
 }
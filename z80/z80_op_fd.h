@@ -371,6 +371,7 @@ void OpyE5() { // push iy
 }
 void OpyE9() { // jp (iy)
 	pc = iy;
+	Jumped();
 }
 void OpyF9() { // ld sp,iy
 	sp = iy;
@@ -96,6 +96,7 @@ void Op10() { // djnz rr
 	if (--b) {
 		signed char offs = (char)Read(pc);
 		memptr = pc += offs+1, t += 9;
+		Jumped();
 	} else pc++, t += 4;
 }
 void Op11() { // ld de,nnnn
@@ -131,6 +132,7 @@ void Op17() { // rla
 void Op18() { // jr rr
 	signed char offs = (char)Read(pc);
 	pc += offs+1;
+	Jumped();
 	memptr = pc;
 	t += 8;
 }
@@ -171,6 +173,7 @@ void Op20() { // jr nz, rr
 	if (!(f & ZF)) {
 		signed char offs = (char)Read(pc);
 		memptr = pc += offs+1, t += 8;
+		Jumped();
 	} else pc++, t += 3;
 }
 void Op21() { // ld hl,nnnn
@@ -209,6 +212,7 @@ void Op28() { // jr z,rr
 	if ((f & ZF)) {
 		signed char offs = (char)Read(pc);
 		memptr = pc += offs+1, t += 8;
+		Jumped();
 	} else pc++, t += 3;
 }
 void Op29() { // add hl,hl
@@ -250,6 +254,7 @@ void Op30() { // jr nc, rr
 	if (!(f & CF)) {
 		signed char offs = (char)Read(pc);
 		memptr = pc += offs+1, t += 8;
+		Jumped();
 	} else pc++, t += 3;
 }
 void Op31() { // ld sp,nnnn
@@ -292,6 +297,7 @@ void Op38() { // jr c,rr
 	if ((f & CF)) {
 		signed char offs = (char)Read(pc);
 		memptr = pc += offs+1, t += 8;
+		Jumped();
 	} else pc++, t += 3;
 }
 void Op39() { // add hl,sp
@@ -494,13 +500,16 @@ void Op76() { // halt
 	halted = 1;
 	unsigned int st = (frame_tacts - t-1)/4+1;
 	t += 4*st;
-	if(handler.io) // replay is active
+	if(fetches >= 0) // replay is active
 	{
 		r_low += fetches;
 		fetches = 0;
 	}
 	else
+	{
 		r_low += st;
+		fetches -= st;
+	}
 }
 void Op77() { // ld (hl),a
 	t += 3;
@@ -733,6 +742,7 @@ void OpC0() { // ret nz
 		unsigned addr = Read(sp++);
 		addr += 0x100*Read(sp++);
 		pc = addr;
+		Jumped();
 		memptr = addr;
 		t += 7;
 	} else t += 1;
@@ -749,11 +759,13 @@ void OpC2() { // jp nz,nnnn
 	memptr = addr;
 	if (!(f & ZF)) {
 		pc = addr;
+		Jumped();
 	} else pc += 2;
 }
 void OpC3() { // jp nnnn
 	unsigned lo = Read(pc++);
 	pc = lo + 0x100*Read(pc);
+	Jumped();
 	memptr = pc;
 	t += 6;
 }
@@ -766,6 +778,7 @@ void OpC4() { // call nz,nnnn
 		Write(--sp, pc_h);
 		Write(--sp, pc_l);
 		pc = addr;
+		Jumped();
 		t += 13;
 	} else t += 6;
 }
@@ -782,6 +795,7 @@ void OpC7() { // rst 00
 	Write(--sp, pc_h);
 	Write(--sp, pc_l);
 	pc = 0x00;
+	Jumped();
 	memptr = 0x00;
 	t += 7;
 }
@@ -790,6 +804,7 @@ void OpC8() { // ret z
 		unsigned addr = Read(sp++);
 		addr += 0x100*Read(sp++);
 		pc = addr;
+		Jumped();
 		memptr = addr;
 		t += 7;
 	} else t += 1;
@@ -798,6 +813,7 @@ void OpC9() { // ret
 	unsigned addr = Read(sp++);
 	addr += 0x100*Read(sp++);
 	pc = addr;
+	Jumped();
 	memptr = addr;
 	t += 6;
 }
@@ -809,6 +825,7 @@ void OpCA() { // jp z,nnnn
 	if(f & ZF)
 	{
 		pc = addr;
+		Jumped();
 	}
 	else
 		pc += 2;
@@ -822,6 +839,7 @@ void OpCC() { // call z,nnnn
 		Write(--sp, pc_h);
 		Write(--sp, pc_l);
 		pc = addr;
+		Jumped();
 		t += 13;
 	} else t += 6;
 }
@@ -831,6 +849,7 @@ void OpCD() { // call
 	Write(--sp, pc_h);
 	Write(--sp, pc_l);
 	pc = addr;
+	Jumped();
 	memptr = addr;
 	t += 13;
 }
@@ -842,6 +861,7 @@ void OpCF() { // rst 08
 	Write(--sp, pc_h);
 	Write(--sp, pc_l);
 	pc = 0x08;
+	Jumped();
 	memptr = 0x08;
 	mem_h = 0;
 	t += 7;
@@ -851,6 +871,7 @@ void OpD0() { // ret nc
 		unsigned addr = Read(sp++);
 		addr += 0x100*Read(sp++);
 		pc = addr;
+		Jumped();
 		memptr = addr;
 		t += 7;
 	} else t += 1;
@@ -867,6 +888,7 @@ void OpD2() { // jp nc,nnnn
 	memptr = addr;
 	if (!(f & CF)) {
 		pc = addr;
+		Jumped();
 	} else pc += 2;
 }
 void OpD3() { // out (nn),a
@@ -884,6 +906,7 @@ void OpD4() { // call nc,nnnn
 		Write(--sp, pc_h);
 		Write(--sp, pc_l);
 		pc = addr;
+		Jumped();
 		t += 13;
 	} else t += 6;
 }
@@ -900,6 +923,7 @@ void OpD7() { // rst 10
 	Write(--sp, pc_h);
 	Write(--sp, pc_l);
 	pc = 0x10;
+	Jumped();
 	memptr = 0x10;
 	t += 7;
 }
@@ -908,6 +932,7 @@ void OpD8() { // ret c
 		unsigned addr = Read(sp++);
 		addr += 0x100*Read(sp++);
 		pc = addr;
+		Jumped();
 		memptr = addr;
 		t += 7;
 	} else t += 1;
@@ -924,6 +949,7 @@ void OpDA() { // jp c,nnnn
 	memptr = addr;
 	if (f & CF) {
 		pc = addr;
+		Jumped();
 	} else pc += 2;
 }
 void OpDB() { // in a,(nn)
@@ -941,6 +967,7 @@ void OpDC() { // call c,nnnn
 		Write(--sp, pc_h);
 		Write(--sp, pc_l);
 		pc = addr;
+		Jumped();
 		t += 13;
 	} else t += 6;
 }
@@ -952,6 +979,7 @@ void OpDF() { // rst 18
 	Write(--sp, pc_h);
 	Write(--sp, pc_l);
 	pc = 0x18;
+	Jumped();
 	memptr = 0x18;
 	t += 7;
 }
@@ -960,6 +988,7 @@ void OpE0() { // ret po
 		unsigned addr = Read(sp++);
 		addr += 0x100*Read(sp++);
 		pc = addr;
+		Jumped();
 		memptr = addr;
 		t += 7;
 	} else t += 1;
@@ -976,6 +1005,7 @@ void OpE2() { // jp po,nnnn
 	memptr = addr;
 	if (!(f & PV)) {
 		pc = addr;
+		Jumped();
 	} else pc += 2;
 }
 void OpE3() { // ex (sp),hl
@@ -995,6 +1025,7 @@ void OpE4() { // call po,nnnn
 		Write(--sp, pc_h);
 		Write(--sp, pc_l);
 		pc = addr;
+		Jumped();
 		t += 13;
 	} else t += 6;
 }
@@ -1011,6 +1042,7 @@ void OpE7() { // rst 20
 	Write(--sp, pc_h);
 	Write(--sp, pc_l);
 	pc = 0x20;
+	Jumped();
 	memptr = 0x20;
 	t += 7;
 }
@@ -1019,12 +1051,14 @@ void OpE8() { // ret pe
 		unsigned addr = Read(sp++);
 		addr += 0x100*Read(sp++);
 		pc = addr;
+		Jumped();
 		memptr = addr;
 		t += 7;
 	} else t += 1;
 }
 void OpE9() { // jp (hl)
 	pc = hl;
+	Jumped();
 }
 void OpEA() { // jp pe,nnnn
 	t += 6;
@@ -1033,6 +1067,7 @@ void OpEA() { // jp pe,nnnn
 	memptr = addr;
 	if (f & PV) {
 		pc = addr;
+		Jumped();
 	} else pc += 2;
 }
 void OpEB() { // ex de,hl
@@ -1049,6 +1084,7 @@ void OpEC() { // call pe,nnnn
 		Write(--sp, pc_h);
 		Write(--sp, pc_l);
 		pc = addr;
+		Jumped();
 		t += 13;
 	} else t += 6;
 }
@@ -1060,6 +1096,7 @@ void OpEF() { // rst 28
 	Write(--sp, pc_h);
 	Write(--sp, pc_l);
 	pc = 0x28;
+	Jumped();
 	memptr = 0x28;
 	t += 7;
 }
@@ -1068,6 +1105,7 @@ void OpF0() { // ret p
 		unsigned addr = Read(sp++);
 		addr += 0x100*Read(sp++);
 		pc = addr;
+		Jumped();
 		memptr = addr;
 		t += 7;
 	} else t += 1;
@@ -1084,6 +1122,7 @@ void OpF2() { // jp p,nnnn
 	memptr = addr;
 	if (!(f & SF)) {
 		pc = addr;
+		Jumped();
 	} else pc += 2;
 }
 void OpF3() { // di
@@ -1098,6 +1137,7 @@ void OpF4() { // call p,nnnn
 		Write(--sp, pc_h);
 		Write(--sp, pc_l);
 		pc = addr;
+		Jumped();
 		t += 13;
 	} else t += 6;
 }
@@ -1114,6 +1154,7 @@ void OpF7() { // rst 30
 	Write(--sp, pc_h);
 	Write(--sp, pc_l);
 	pc = 0x30;
+	Jumped();
 	memptr = 0x30;
 	t += 7;
 }
@@ -1122,6 +1163,7 @@ void OpF8() { // ret m
 		unsigned addr = Read(sp++);
 		addr += 0x100*Read(sp++);
 		pc = addr;
+		Jumped();
 		memptr = addr;
 		t += 7;
 	} else t += 1;
@@ -1137,6 +1179,7 @@ void OpFA() { // jp m,nnnn
 	memptr = addr;
 	if (f & SF) {
 		pc = addr;
+		Jumped();
 	} else pc += 2;
 }
 void OpFB() { // ei
@@ -1152,6 +1195,7 @@ void OpFC() { // call m,nnnn
 		Write(--sp, pc_h);
 		Write(--sp, pc_l);
 		pc = addr;
+		Jumped();
 		t += 13;
 	} else t += 6;
 }
@@ -1163,6 +1207,7 @@ void OpFF() { // rst 38
 	Write(--sp, pc_h);
 	Write(--sp, pc_l);
 	pc = 0x38;
+	Jumped();
 	memptr = 0x38;
 	t += 7;
 }
@@ -0,0 +1,120 @@
+/*
+Portable ZX-Spectrum emulator.
+Copyright (C) 2001-2012 SMT, Dexus, Alone Coder, deathsoft, djdron, scor
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "../std.h"
+#include "../devices/memory.h"
+#include "z80_trace.h"
+
+namespace xZ80
+{
+
+static byte* Put16(byte* p, word v) { p[0] = v; p[1] = v >> 8; return p + 2; }
+static byte* Put32(byte* p, dword v) { p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24; return p + 4; }
+
+struct eZ80AccessorTrace : public eZ80
+{
+	void Store(byte* p) const
+	{
+		p = Put16(p, pc);
+		for(int i = 0; i < 4; ++i)
+			*p++ = memory->Read(pc + i);
+		p = Put16(p, af); p = Put16(p, bc); p = Put16(p, de); p = Put16(p, hl);
+		p = Put16(p, alt.af); p = Put16(p, alt.bc); p = Put16(p, alt.de); p = Put16(p, alt.hl);
+		p = Put16(p, ix); p = Put16(p, iy); p = Put16(p, sp); p = Put16(p, ir); p = Put16(p, memptr);
+		p = Put32(p, t);
+		*p = iff1|(iff2 << 1)|(halted << 2)|(im << 3);
+	}
+};
+
+//=============================================================================
+//	eTrace::Open
+//-----------------------------------------------------------------------------
+bool eTrace::Open(const char* name)
+{
+	Close();
+	file = fopen(name, "wb");
+	if(!file)
+		return false;
+	bool ok = true;
+#ifdef USE_ZIP
+	ok = packer.Start(file, Z_BEST_SPEED, true);
+#endif//USE_ZIP
+	if(!ok)
+	{
+		fclose(file);
+		file = NULL;
+		remove(name);
+		return false;
+	}
+	Write((const byte*)Signature(), strlen(Signature()));
+	return true;
+}
+//=============================================================================
+//	eTrace::Close
+//-----------------------------------------------------------------------------
+bool eTrace::Close()
+{
+	if(!file)
+		return false;
+	bool ok = true;
+#ifdef USE_ZIP
+	ok = packer.Finish();
+#endif//USE_ZIP
+	ok = fclose(file) == 0 && ok;
+	file = NULL;
+	return ok;
+}
+//=============================================================================
+//	eTrace::Write
+//-----------------------------------------------------------------------------
+void eTrace::Write(const byte* data, size_t size)
+{
+#ifdef USE_ZIP
+	packer.Write(data, size);
+#else//USE_ZIP
+	fwrite(data, 1, size, file);
+#endif//USE_ZIP
+}
+//=============================================================================
+//	eTrace::Z80_Trace
+//-----------------------------------------------------------------------------
+void eTrace::Z80_Trace(eZ80* z80, bool int_taken)
+{
+	if(!file)
+		return;
+	byte r[STATE_SIZE];
+	r[0] = int_taken ? R_INT : R_STEP;
+	((const eZ80AccessorTrace*)z80)->Store(r + 1);
+	Write(r, sizeof(r));
+}
+//=============================================================================
+//	eTrace::Z80_TraceIo
+//-----------------------------------------------------------------------------
+void eTrace::Z80_TraceIo(word port, byte v, int tact, bool write)
+{
+	if(!file)
+		return;
+	byte r[IO_SIZE];
+	r[0] = write ? R_IO_WRITE : R_IO_READ;
+	Put16(r + 1, port);
+	r[3] = v;
+	Put32(r + 4, tact);
+	Write(r, sizeof(r));
+}
+
+}//namespace xZ80
@@ -0,0 +1,78 @@
+/*
+Portable ZX-Spectrum emulator.
+Copyright (C) 2001-2012 SMT, Dexus, Alone Coder, deathsoft, djdron, scor
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef	__Z80_TRACE_H__
+#define	__Z80_TRACE_H__
+
+#include "z80.h"
+#include "../tools/packer.h"
+
+#pragma once
+
+namespace xZ80
+{
+
+//*****************************************************************************
+//	eTrace
+//-----------------------------------------------------------------------------
+// execution trace written into file: cpu state before each opcode and int,
+// every port access. records are packed into gzip file in helper thread
+//-----------------------------------------------------------------------------
+class eTrace : public eZ80::eHandlerTrace
+{
+public:
+	eTrace() : file(NULL) {}
+	virtual ~eTrace() { Close(); }
+	bool Open(const char* name);
+	bool Close();
+
+	virtual void Z80_Trace(eZ80* z80, bool int_taken);
+	virtual void Z80_TraceIo(word port, byte v, int tact, bool write);
+
+	// file is SIGNATURE followed by records (type byte & little endian data)
+	static const char* Signature() { return "USPTRACE"; }
+	enum eRecord
+	{
+		R_STEP		= 'S',	// pc, 4 opcode bytes, af, bc, de, hl, af', bc', de', hl',
+							// ix, iy, sp, ir, memptr, t (dword), iff1|iff2<<1|halted<<2|im<<3
+		R_INT		= 'I',	// the same as R_STEP
+		R_IO_READ	= 'R',	// port, value, t (dword)
+		R_IO_WRITE	= 'W',
+	};
+	enum { STATE_SIZE = 1 + 2 + 4 + 13*2 + 4 + 1, IO_SIZE = 1 + 2 + 1 + 4 };
+	static size_t RecordSize(byte type) // 0 if unknown type
+	{
+		switch(type)
+		{
+		case R_STEP: case R_INT:			return STATE_SIZE;
+		case R_IO_READ: case R_IO_WRITE:	return IO_SIZE;
+		}
+		return 0;
+	}
+
+private:
+	void Write(const byte* data, size_t size);
+	FILE* file;
+#ifdef USE_ZIP
+	xIo::ePacker packer;
+#endif//USE_ZIP
+};
+
+}//namespace xZ80
+
+#endif//__Z80_TRACE_H__